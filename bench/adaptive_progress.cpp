@@ -0,0 +1,74 @@
+// Idle CPU and wake-up latency of the spin and adaptive progress modes.
+//
+// Idle CPU is the process CPU time consumed while the context has nothing to
+// do. Wake-up latency is measured from schedule() on the main thread to the
+// task running on the PE thread, after the loop has been idle long enough to
+// fall asleep.
+
+#include <doca_stdexec/progress_engine.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <stdexec/execution.hpp>
+#include <sys/resource.h>
+#include <thread>
+#include <vector>
+
+using namespace doca_stdexec;
+using namespace std::chrono_literals;
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+double process_cpu_seconds() {
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    auto to_seconds = [](timeval tv) { return tv.tv_sec + tv.tv_usec * 1e-6; };
+    return to_seconds(usage.ru_utime) + to_seconds(usage.ru_stime);
+}
+
+void measure(const char* name, loop::run_loop_options options) {
+    doca_pe_context context{options};
+
+    // let the loop settle into its idle state
+    std::this_thread::sleep_for(100ms);
+
+    auto cpu_begin = process_cpu_seconds();
+    auto wall_begin = clock_type::now();
+    std::this_thread::sleep_for(1s);
+    auto idle_cpu = (process_cpu_seconds() - cpu_begin) /
+                    std::chrono::duration<double>(clock_type::now() - wall_begin).count();
+
+    constexpr size_t samples = 500;
+    std::vector<double> latencies;
+    latencies.reserve(samples);
+
+    for (size_t i = 0; i < samples; i++) {
+        std::this_thread::sleep_for(options.spin_window + 1ms);
+
+        auto scheduled = clock_type::now();
+        auto [woken] = stdexec::sync_wait(stdexec::schedule(context.get_scheduler()) |
+                                          stdexec::then([] { return clock_type::now(); }))
+                           .value();
+        latencies.push_back(std::chrono::duration<double, std::micro>(woken - scheduled).count());
+    }
+
+    std::ranges::sort(latencies);
+    auto percentile = [&](double p) { return latencies[static_cast<size_t>(p * (latencies.size() - 1))]; };
+
+    printf("%-10s %10.1f%% %10.2f %10.2f %10.2f\n", name, idle_cpu * 100, percentile(0.5), percentile(0.99),
+           latencies.back());
+}
+
+} // namespace
+
+int main() {
+    printf("%-10s %11s %10s %10s %10s\n", "mode", "idle cpu", "p50 us", "p99 us", "max us");
+
+    measure("spin", {.mode = loop::progress_mode::spin});
+    measure("adaptive", {.mode = loop::progress_mode::adaptive, .spin_window = 100us});
+
+    return 0;
+}
@@ -0,0 +1,44 @@
+// Write rate with far more senders in flight than the Rdma context has
+// DOCA tasks.
+//
+// The write pool is sized from the send queue and capped at 1024 tasks; the
+// operations beyond that wait in the task cache for a completion to release
+// one, instead of failing allocate_init.
+
+#include "rdma_bench.hpp"
+
+#include <cstdio>
+#include <stdexec/execution.hpp>
+
+using namespace doca_stdexec;
+
+namespace {
+
+constexpr size_t message_size = 8;
+constexpr size_t total = 2000000;
+
+void measure(bench::loopback& pair, bench::memory_pair& memory, size_t window) {
+    auto before = pair.rdma->tasks.stats();
+    auto rate = bench::run_closed_loop(
+        pair.context.get_scheduler(), [&] { return memory.write_on(*pair.connection); }, window, total);
+    auto after = pair.rdma->tasks.stats();
+
+    printf("%8zu %14.0f %12llu %14.4f\n", window, rate,
+           static_cast<unsigned long long>(after.allocated - before.allocated),
+           static_cast<double>(after.parked - before.parked) / total);
+}
+
+} // namespace
+
+int main() {
+    auto device = Device::open_from_ib_name(bench::device_name);
+    bench::loopback pair{device};
+    bench::memory_pair memory{device, message_size};
+
+    printf("%8s %14s %12s %14s\n", "window", "msgs/s", "allocated", "parked/msg");
+    for (size_t window : {16, 256, 1024, 4096, 16384}) {
+        measure(pair, memory, window);
+    }
+
+    return 0;
+}
@@ -0,0 +1,71 @@
+// Small-write rate of `pieces` writes issued as separate senders, each with
+// its own operation state and completion, and as one write_bulk.
+//
+// Both keep `pieces` writes in flight; the bulk transfer completes once per
+// round and refills its window from the completions of its pieces.
+
+#include "rdma_bench.hpp"
+
+#include <cstdio>
+#include <stdexec/execution.hpp>
+#include <utility>
+#include <vector>
+
+using namespace doca_stdexec;
+
+namespace {
+
+constexpr size_t message_size = 8;
+// bounded by the 64 buffers of the memory pair's inventory
+constexpr size_t pieces = 32;
+constexpr size_t rounds = 50000;
+
+void report(const char* name, double rate) {
+    printf("%-10s %14.0f\n", name, rate);
+}
+
+} // namespace
+
+int main() {
+    auto device = Device::open_from_ib_name(bench::device_name);
+    bench::loopback pair{device};
+    bench::memory_pair memory{device, message_size * pieces};
+    auto& connection = *pair.connection;
+
+    // one destination slice per piece, DOCA appends to a destination
+    std::vector<std::pair<Buf, Buf>> items;
+    memory.src.set_data_len(message_size);
+    auto* remote = memory.remote_mmap->get_memrange().data();
+    for (size_t i = 0; i < pieces; i++) {
+        auto dst = memory.inventory.get_buffer_by_addr(*memory.remote_mmap, remote + i * message_size, message_size);
+        items.emplace_back(memory.src, std::move(dst));
+    }
+    auto rewind = [&] {
+        for (auto& [src, dst] : items) {
+            dst.set_data_len(0);
+        }
+    };
+
+    printf("%-10s %14s\n", "submit", "msgs/s");
+
+    size_t next = 0;
+    report("separate", bench::run_closed_loop(
+                           pair.context.get_scheduler(),
+                           [&] {
+                               auto& dst = items[next++ % pieces].second;
+                               dst.set_data_len(0);
+                               return connection.write(memory.src, dst);
+                           },
+                           pieces, pieces * rounds));
+
+    auto rate = bench::run_closed_loop(
+        pair.context.get_scheduler(),
+        [&] {
+            rewind();
+            return connection.write_bulk(items, {.window = pieces});
+        },
+        1, rounds);
+    report("bulk", rate * pieces);
+
+    return 0;
+}
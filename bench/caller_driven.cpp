@@ -0,0 +1,126 @@
+// Ping-pong latency with a dedicated PE thread and with the calling thread
+// driving the PE through doca_stdexec::sync_wait.
+//
+// A ping is either an empty schedule() onto the loop, which isolates the
+// thread hops, or an RDMA write to the peer and back to its completion.
+// With a PE thread every ping hops from the caller to the PE thread and
+// back; driven by the caller it never leaves the calling thread.
+
+#include "rdma_bench.hpp"
+
+#include <doca_stdexec/sync_wait.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <optional>
+#include <stdexec/execution.hpp>
+#include <thread>
+#include <vector>
+
+using namespace doca_stdexec;
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+constexpr size_t message_size = 64;
+constexpr size_t pings = 100000;
+
+template <typename Ping>
+void measure(const char* name, Ping ping) {
+    std::vector<double> latencies;
+    latencies.reserve(pings);
+    for (size_t i = 0; i < pings; i++) {
+        auto issued = clock_type::now();
+        ping();
+        latencies.push_back(std::chrono::duration<double, std::micro>(clock_type::now() - issued).count());
+    }
+
+    std::ranges::sort(latencies);
+    auto percentile = [&](double p) { return latencies[static_cast<size_t>(p * (latencies.size() - 1))]; };
+    printf("%-20s %10.2f %10.2f %10.2f\n", name, percentile(0.5), percentile(0.99), latencies.back());
+}
+
+/**
+ * @brief An Rdma context on a loop driven by the main thread, connected to
+ *        a peer on a PE thread of its own
+ */
+struct caller_loopback {
+    std::shared_ptr<Device> device;
+    run_loop loop{ProgressEngine{}};
+    doca_pe_context peer_context;
+    std::shared_ptr<rdma::Rdma> rdma;
+    std::shared_ptr<rdma::Rdma> peer_rdma;
+    std::optional<rdma::RdmaConnection> connection;
+    std::optional<rdma::RdmaConnection> peer;
+
+    explicit caller_loopback(std::shared_ptr<Device> dev) : device(std::move(dev)) {
+        rdma = rdma::Rdma::open_from_dev(device);
+        rdma->set_gid_index(bench::gid_index);
+        doca_stdexec::sync_wait(loop, stdexec::just() | stdexec::then([&] {
+                                          loop.connect_ctx(rdma);
+                                          rdma->start();
+                                      }));
+
+        peer_rdma = rdma::Rdma::open_from_dev(device);
+        peer_rdma->set_gid_index(bench::gid_index);
+        stdexec::sync_wait(stdexec::schedule(peer_context.get_scheduler()) | stdexec::then([&] {
+                               peer_context.connect_ctx(peer_rdma);
+                               peer_rdma->start();
+                           }));
+
+        // both ends exchange descriptors over the socket pair at once
+        auto [a, b] = bench::socket_pair();
+        std::thread remote([&] {
+            auto [connected] = stdexec::sync_wait(stdexec::schedule(peer_context.get_scheduler()) |
+                                                  stdexec::let_value([&] { return peer_rdma->connect(b); }))
+                                   .value();
+            peer.emplace(std::move(connected));
+        });
+        auto [local] =
+            doca_stdexec::sync_wait(loop, stdexec::just() | stdexec::let_value([&] { return rdma->connect(a); }))
+                .value();
+        connection.emplace(std::move(local));
+        remote.join();
+    }
+
+    ~caller_loopback() {
+        connection.reset();
+        peer.reset();
+        doca_stdexec::sync_wait(loop, stdexec::just() | stdexec::then([&] { rdma->stop(); }));
+        stdexec::sync_wait(stdexec::schedule(peer_context.get_scheduler()) |
+                           stdexec::then([&] { peer_rdma->stop(); }));
+    }
+};
+
+} // namespace
+
+int main() {
+    auto device = Device::open_from_ib_name(bench::device_name);
+
+    printf("%-20s %10s %10s %10s\n", "mode", "p50 us", "p99 us", "max us");
+
+    {
+        bench::loopback pair{device};
+        bench::memory_pair memory{device, message_size};
+        auto scheduler = pair.context.get_scheduler();
+
+        measure("pe thread schedule", [&] { stdexec::sync_wait(stdexec::schedule(scheduler)); });
+        measure("pe thread write", [&] {
+            stdexec::sync_wait(stdexec::schedule(scheduler) |
+                               stdexec::let_value([&] { return memory.write_on(*pair.connection); }));
+        });
+    }
+
+    {
+        caller_loopback pair{device};
+        bench::memory_pair memory{device, message_size};
+        auto scheduler = pair.loop.get_scheduler();
+
+        measure("caller schedule", [&] { doca_stdexec::sync_wait(pair.loop, stdexec::schedule(scheduler)); });
+        measure("caller write", [&] { doca_stdexec::sync_wait(pair.loop, memory.write_on(*pair.connection)); });
+    }
+
+    return 0;
+}
@@ -0,0 +1,56 @@
+// Enqueues per operation for a write followed by a read, transitioning back
+// to the connection's own scheduler after each.
+//
+// `continues_on` goes through the run loop's domain, which drops both hops
+// since the RDMA senders already complete on that scheduler.
+// `schedule_from` is what continues_on lowers to without the domain and
+// always schedules. A hop shows up as a task, queued or run inline.
+
+#include "rdma_bench.hpp"
+
+#include <cstdio>
+#include <stdexec/execution.hpp>
+
+using namespace doca_stdexec;
+
+namespace {
+
+constexpr size_t message_size = 64;
+constexpr size_t window = 16;
+constexpr size_t total = 200000;
+
+template <typename Factory>
+void measure(const char* name, bench::loopback& pair, Factory factory) {
+    auto before = pair.context.stats();
+    auto rate = bench::run_closed_loop(pair.context.get_scheduler(), factory, window, total);
+    auto after = pair.context.stats();
+
+    auto per_op = [](uint64_t begin, uint64_t end) { return static_cast<double>(end - begin) / total; };
+    printf("%-16s %12.0f %12.3f %12.3f\n", name, rate, per_op(before.tasks_executed, after.tasks_executed),
+           per_op(before.tasks_inlined, after.tasks_inlined));
+}
+
+} // namespace
+
+int main() {
+    auto device = Device::open_from_ib_name(bench::device_name);
+    bench::loopback pair{device};
+    bench::memory_pair memory{device, message_size};
+    auto& connection = *pair.connection;
+    auto scheduler = pair.context.get_scheduler();
+
+    printf("%-16s %12s %12s %12s\n", "transition", "chains/s", "queued/op", "inlined/op");
+
+    measure("continues_on", pair, [&] {
+        return memory.write_on(connection) | stdexec::continues_on(scheduler) |
+               stdexec::let_value([&] { return memory.read_on(connection) | stdexec::continues_on(scheduler); });
+    });
+
+    measure("schedule_from", pair, [&] {
+        return stdexec::schedule_from(scheduler, memory.write_on(connection)) | stdexec::let_value([&] {
+                   return stdexec::schedule_from(scheduler, memory.read_on(connection));
+               });
+    });
+
+    return 0;
+}
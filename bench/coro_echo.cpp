@@ -0,0 +1,83 @@
+// Round trips of a write followed by a read of the same bytes, written as a
+// coroutine loop and as the equivalent sender chain.
+//
+// The coroutine awaits a nested round_trip() task per iteration, so every
+// iteration creates and destroys a frame; the frame pool of the PE thread
+// should serve all of them after the first. The sender chain runs
+// write | let_value(read) one at a time through bench::closed_loop.
+
+#include "rdma_bench.hpp"
+
+#include <doca_stdexec/coro.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <stdexec/execution.hpp>
+
+using namespace doca_stdexec;
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+constexpr size_t message_size = 64;
+constexpr size_t round_trips = 200000;
+
+coro::task<> round_trip(rdma::RdmaConnection& connection, bench::memory_pair& memory) {
+    co_await memory.write_on(connection);
+    co_await memory.read_on(connection);
+}
+
+coro::task<> echo_loop(rdma::RdmaConnection& connection, bench::memory_pair& memory, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        co_await round_trip(connection, memory);
+    }
+}
+
+void report(const char* name, double seconds, const loop::run_loop_stats& window) {
+    printf("%-10s %12.0f %12.2f %14llu %14llu\n", name, static_cast<double>(round_trips) / seconds,
+           seconds * 1e6 / static_cast<double>(round_trips), static_cast<unsigned long long>(window.frames_allocated),
+           static_cast<unsigned long long>(window.frames_recycled));
+}
+
+} // namespace
+
+int main() {
+    auto device = Device::open_from_ib_name(bench::device_name);
+    bench::loopback pair{device};
+    bench::memory_pair memory{device, message_size};
+    auto& connection = *pair.connection;
+    auto& context = pair.context;
+    auto scheduler = context.get_scheduler();
+
+    printf("%-10s %12s %12s %14s %14s\n", "mode", "trips/s", "us/trip", "frames alloc", "frames reused");
+
+    {
+        auto before = context.stats();
+        auto begin = clock_type::now();
+        bench::run_closed_loop(
+            scheduler,
+            [&] {
+                return memory.write_on(connection) | stdexec::let_value([&] { return memory.read_on(connection); });
+            },
+            1, round_trips);
+        report("senders", std::chrono::duration<double>(clock_type::now() - begin).count(),
+               context.stats().since(before));
+    }
+
+    {
+        // warm the frame pool so the window shows the steady state only
+        stdexec::sync_wait(stdexec::schedule(scheduler) |
+                           stdexec::let_value([&] { return echo_loop(connection, memory, 16); }));
+
+        auto before = context.stats();
+        auto begin = clock_type::now();
+        // created inside let_value, so the frames come from the PE thread's pool
+        stdexec::sync_wait(stdexec::schedule(scheduler) |
+                           stdexec::let_value([&] { return echo_loop(connection, memory, round_trips); }));
+        report("coroutine", std::chrono::duration<double>(clock_type::now() - begin).count(),
+               context.stats().since(before));
+    }
+
+    return 0;
+}
@@ -0,0 +1,57 @@
+// Small-write rate in bursts of `burst` writes joined with when_all.
+//
+// when_all of plain RDMA senders goes through the run loop's domain, which
+// submits the burst with one doorbell. Wrapping each write in `then` hides
+// it from the domain, so every write rings its own.
+
+#include "rdma_bench.hpp"
+
+#include <cstdio>
+#include <stdexec/execution.hpp>
+#include <utility>
+
+using namespace doca_stdexec;
+
+namespace {
+
+constexpr size_t message_size = 8;
+constexpr size_t burst = 8;
+// bursts in flight
+constexpr size_t window = 8;
+constexpr size_t total = 250000;
+
+template <typename Factory>
+void measure(const char* name, bench::loopback& pair, Factory factory) {
+    auto before = pair.rdma->bell.stats();
+    auto rate = bench::run_closed_loop(pair.context.get_scheduler(), factory, window, total);
+    auto after = pair.rdma->bell.stats();
+
+    printf("%-10s %14.0f %14.4f\n", name, rate * burst,
+           static_cast<double>(after.flushes - before.flushes) / (after.submitted - before.submitted));
+}
+
+template <typename Write>
+auto burst_of(Write write) {
+    return [&]<size_t... I>(std::index_sequence<I...>) {
+        return stdexec::when_all(((void)I, write())...);
+    }(std::make_index_sequence<burst>{});
+}
+
+} // namespace
+
+int main() {
+    auto device = Device::open_from_ib_name(bench::device_name);
+    bench::loopback pair{device};
+    bench::memory_pair memory{device, message_size};
+    auto& connection = *pair.connection;
+
+    printf("%-10s %14s %14s\n", "submit", "msgs/s", "doorbells/msg");
+
+    measure("separate", pair, [&] {
+        return burst_of([&] { return memory.write_on(connection) | stdexec::then([] {}); });
+    });
+
+    measure("batched", pair, [&] { return burst_of([&] { return memory.write_on(connection); }); });
+
+    return 0;
+}
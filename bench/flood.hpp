@@ -0,0 +1,106 @@
+#pragma once
+#ifndef DOCA_STDEXEC_BENCH_FLOOD_HPP
+#define DOCA_STDEXEC_BENCH_FLOOD_HPP
+
+// CPU-bound background load on a PE thread, shared by the benchmarks that
+// measure latency under a saturated run loop.
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <new>
+#include <stdexec/execution.hpp>
+#include <vector>
+
+namespace bench {
+
+inline void busy_for(std::chrono::nanoseconds duration) {
+    auto end = std::chrono::steady_clock::now() + duration;
+    while (std::chrono::steady_clock::now() < end) {
+    }
+}
+
+/**
+ * @brief Keeps `window` self-rescheduling tasks of `task_cost` each on the PE thread until stopped
+ */
+template <typename Scheduler>
+class flood {
+    struct receiver {
+        using receiver_concept = stdexec::receiver_t;
+
+        flood* self;
+        size_t slot;
+
+        void set_value() noexcept {
+            self->on_complete_(slot);
+        }
+
+        void set_error(std::exception_ptr) noexcept {
+            std::terminate();
+        }
+
+        void set_stopped() noexcept {
+            std::terminate();
+        }
+
+        [[nodiscard]]
+        stdexec::env<> get_env() const noexcept {
+            return {};
+        }
+    };
+
+    using op_t = stdexec::connect_result_t<decltype(stdexec::schedule(std::declval<Scheduler&>())), receiver>;
+
+    struct slot_storage {
+        alignas(op_t) std::byte bytes[sizeof(op_t)];
+    };
+
+public:
+    flood(Scheduler scheduler, size_t window, std::chrono::nanoseconds task_cost)
+        : scheduler_(scheduler), task_cost_(task_cost), slots_(window), outstanding_(window) {}
+
+    void start() {
+        stdexec::sync_wait(stdexec::schedule(scheduler_) | stdexec::then([this] {
+                               for (size_t slot = 0; slot < slots_.size(); slot++) {
+                                   start_slot_(slot);
+                               }
+                           }));
+    }
+
+    // returns the number of flood tasks executed
+    size_t stop() {
+        running_.store(false, std::memory_order_relaxed);
+        while (outstanding_.load(std::memory_order_acquire) != 0) {
+        }
+        return executed_;
+    }
+
+private:
+    void start_slot_(size_t slot) {
+        auto* op = ::new (slots_[slot].bytes) op_t(stdexec::connect(stdexec::schedule(scheduler_), receiver{this, slot}));
+        stdexec::start(*op);
+    }
+
+    void on_complete_(size_t slot) noexcept {
+        busy_for(task_cost_);
+        executed_++;
+        std::launder(reinterpret_cast<op_t*>(slots_[slot].bytes))->~op_t();
+        if (running_.load(std::memory_order_relaxed)) {
+            start_slot_(slot);
+        } else {
+            outstanding_.fetch_sub(1, std::memory_order_release);
+        }
+    }
+
+    Scheduler scheduler_;
+    std::chrono::nanoseconds task_cost_;
+    std::vector<slot_storage> slots_;
+    size_t executed_ = 0;
+    std::atomic<bool> running_ = true;
+    std::atomic<size_t> outstanding_;
+};
+
+} // namespace bench
+
+#endif // DOCA_STDEXEC_BENCH_FLOOD_HPP
@@ -0,0 +1,62 @@
+// Rate of writes of a message made of a header and a payload held in
+// separate buffers.
+//
+// "staging" copies both into one buffer before each write, "gather" writes
+// from a buffer list of the two built once with gather_list, and DOCA reads
+// the parts where they are.
+
+#include "rdma_bench.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <stdexec/execution.hpp>
+
+using namespace doca_stdexec;
+
+namespace {
+
+constexpr size_t header_size = 64;
+constexpr size_t payload_size = 4096;
+constexpr size_t message_size = header_size + payload_size;
+constexpr size_t window = 16;
+constexpr size_t total = 1000000;
+
+template <typename Factory>
+void measure(const char* name, bench::loopback& pair, Factory factory) {
+    auto rate = bench::run_closed_loop(pair.context.get_scheduler(), factory, window, total);
+    printf("%-10s %14.0f %14.2f\n", name, rate, rate * message_size / 1e9);
+}
+
+} // namespace
+
+int main() {
+    auto device = Device::open_from_ib_name(bench::device_name);
+    bench::loopback pair{device};
+    // local memory holds the header, then the staging buffer, then the payload
+    bench::memory_pair memory{device, 2 * message_size};
+    auto& connection = *pair.connection;
+
+    auto* local = memory.local_mmap->get_memrange().data();
+    auto header = memory.inventory.get_buffer_by_addr(*memory.local_mmap, local, header_size);
+    auto staging = memory.inventory.get_buffer_by_addr(*memory.local_mmap, local + header_size, message_size);
+    auto payload =
+        memory.inventory.get_buffer_by_addr(*memory.local_mmap, local + header_size + message_size, payload_size);
+
+    auto write_to_dst = [&](Buf& src) {
+        memory.dst.set_data_len(0);
+        return connection.write(src, memory.dst);
+    };
+
+    printf("%-10s %14s %14s\n", "source", "msgs/s", "GB/s");
+
+    measure("staging", pair, [&] {
+        std::memcpy(staging.get_data(), header.get_data(), header_size);
+        std::memcpy(static_cast<std::byte*>(staging.get_data()) + header_size, payload.get_data(), payload_size);
+        return write_to_dst(staging);
+    });
+
+    auto message = gather_list{header, pair.rdma->max_write_gather_len()}.append(payload).build();
+    measure("gather", pair, [&] { return write_to_dst(message); });
+
+    return 0;
+}
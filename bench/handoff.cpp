@@ -0,0 +1,76 @@
+// Cost of moving bursts of completions from a PE thread to a thread pool,
+// with continues_on(pool) and through a handoff_channel.
+//
+// A burst starts `burst` continuations from one PE task, as the completions
+// of one poll would. Each continuation only bumps a counter on the pool; a
+// sample is timed from the start of the burst until the last one has run.
+// continues_on(pool) enqueues every continuation on the pool separately,
+// the channel enqueues one drain per pass.
+
+#include <doca_stdexec/handoff.hpp>
+#include <doca_stdexec/progress_engine.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <exec/static_thread_pool.hpp>
+#include <stdexec/execution.hpp>
+
+using namespace doca_stdexec;
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+constexpr size_t burst = 1000;
+constexpr size_t samples = 2000;
+
+// nanoseconds per continuation, from the first start to the last completion
+template <typename Scheduler>
+double measure_bursts(doca_pe_context& context, Scheduler target) {
+    std::atomic<size_t> remaining;
+    double total = 0;
+    for (size_t i = 0; i < samples; i++) {
+        remaining.store(burst, std::memory_order_relaxed);
+        auto [begin] = stdexec::sync_wait(stdexec::schedule(context.get_scheduler()) | stdexec::then([&] {
+                                              auto begin = clock_type::now();
+                                              for (size_t j = 0; j < burst; j++) {
+                                                  stdexec::start_detached(
+                                                      stdexec::schedule(target) | stdexec::then([&] {
+                                                          if (remaining.fetch_sub(1) == 1) {
+                                                              remaining.notify_one();
+                                                          }
+                                                      }));
+                                              }
+                                              return begin;
+                                          }))
+                           .value();
+        for (auto left = remaining.load(); left != 0; left = remaining.load()) {
+            remaining.wait(left);
+        }
+        total += std::chrono::duration<double, std::nano>(clock_type::now() - begin).count();
+    }
+    return total / static_cast<double>(samples * burst);
+}
+
+} // namespace
+
+int main() {
+    doca_pe_context context;
+    exec::static_thread_pool pool{4};
+    auto pool_scheduler = pool.get_scheduler();
+
+    printf("%-14s %12s %16s\n", "mode", "ns/item", "items/wakeup");
+
+    auto naive = measure_bursts(context, pool_scheduler);
+    printf("%-14s %12.1f %16.1f\n", "continues_on", naive, 1.0);
+
+    handoff_channel channel{context, pool_scheduler};
+    auto batched = measure_bursts(context, channel.get_scheduler());
+    auto stats = channel.stats();
+    printf("%-14s %12.1f %16.1f\n", "handoff", batched, stats.per_wakeup());
+    printf("handed off %llu, bypassed %llu, wakeups %llu\n", static_cast<unsigned long long>(stats.handed_off),
+           static_cast<unsigned long long>(stats.bypassed), static_cast<unsigned long long>(stats.wakeups));
+
+    return 0;
+}
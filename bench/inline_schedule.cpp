@@ -0,0 +1,71 @@
+// Latency of continues_on() hops between tasks that already run on the PE
+// thread, with the inline schedule() fast path and without it.
+//
+// Each sample runs a chain of `hops` continues_on(scheduler) hops on the PE
+// thread; the per-hop cost is the difference to a chain without hops,
+// divided by the number of hops.
+
+#include <doca_stdexec/progress_engine.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <stdexec/execution.hpp>
+
+using namespace doca_stdexec;
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+constexpr size_t hops = 32;
+constexpr size_t samples = 20000;
+
+template <size_t N, typename Scheduler>
+auto chain(Scheduler scheduler) {
+    if constexpr (N == 0) {
+        return stdexec::just();
+    } else {
+        return chain<N - 1>(scheduler) | stdexec::continues_on(scheduler);
+    }
+}
+
+// nanoseconds spent on the PE thread per chain of N hops, averaged
+template <size_t N, typename Scheduler>
+double measure_chain(Scheduler scheduler) {
+    double total = 0;
+    for (size_t i = 0; i < samples; i++) {
+        auto [elapsed] = stdexec::sync_wait(stdexec::schedule(scheduler) | stdexec::let_value([scheduler] {
+                                                auto begin = clock_type::now();
+                                                return chain<N>(scheduler) | stdexec::then([begin] {
+                                                           return clock_type::now() - begin;
+                                                       });
+                                            }))
+                             .value();
+        total += std::chrono::duration<double, std::nano>(elapsed).count();
+    }
+    return total / samples;
+}
+
+void measure(const char* name, unsigned max_inline_depth) {
+    doca_pe_context context{loop::run_loop_options{.max_inline_depth = max_inline_depth}};
+    auto scheduler = context.get_scheduler();
+
+    auto empty = measure_chain<0>(scheduler);
+    auto before = context.stats();
+    auto full = measure_chain<hops>(scheduler);
+    auto after = context.stats();
+
+    printf("%-10s %12.1f %12.1f %14llu\n", name, full / 1000, (full - empty) / hops,
+           static_cast<unsigned long long>(after.tasks_inlined - before.tasks_inlined));
+}
+
+} // namespace
+
+int main() {
+    printf("%-10s %12s %12s %14s\n", "mode", "chain us", "ns/hop", "inlined");
+
+    measure("queued", 0);
+    measure("inline", 16);
+
+    return 0;
+}
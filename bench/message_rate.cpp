@@ -0,0 +1,44 @@
+// Small-message write rate with DOCA tasks allocated and freed per
+// operation, and taken from the Rdma context's task cache.
+//
+// Without the cache every operation goes through allocate_init and
+// doca_task_free; with it only the first `window` do.
+
+#include "rdma_bench.hpp"
+
+#include <cstdio>
+#include <stdexec/execution.hpp>
+
+using namespace doca_stdexec;
+
+namespace {
+
+constexpr size_t message_size = 8;
+// below the size of the write task pool, so no operation waits for a task
+constexpr size_t window = 16;
+constexpr size_t total = 2000000;
+
+void measure(const char* name, bench::loopback& pair, bench::memory_pair& memory, bool cached) {
+    auto scheduler = pair.context.get_scheduler();
+    stdexec::sync_wait(stdexec::schedule(scheduler) | stdexec::then([&] { pair.rdma->tasks.set_enabled(cached); }));
+
+    auto before = pair.rdma->tasks.stats();
+    auto rate = bench::run_closed_loop(scheduler, [&] { return memory.write_on(*pair.connection); }, window, total);
+    auto after = pair.rdma->tasks.stats();
+
+    printf("%-10s %14.0f %14.4f\n", name, rate, static_cast<double>(after.allocated - before.allocated) / total);
+}
+
+} // namespace
+
+int main() {
+    auto device = Device::open_from_ib_name(bench::device_name);
+    bench::loopback pair{device};
+    bench::memory_pair memory{device, message_size};
+
+    printf("%-10s %14s %14s\n", "tasks", "msgs/s", "allocs/msg");
+    measure("allocated", pair, memory, false);
+    measure("cached", pair, memory, true);
+
+    return 0;
+}
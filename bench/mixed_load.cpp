@@ -0,0 +1,78 @@
+// RDMA write latency on a PE thread that is flooded with scheduled tasks,
+// for several pass budgets.
+//
+// The flood keeps a window of CPU-bound tasks rescheduling themselves on the
+// PE thread, which never runs out of work; without a task budget the loop
+// would never poll for completions again. The probe measures round trips of
+// single writes started on the PE thread from the main thread.
+
+#include "flood.hpp"
+#include "rdma_bench.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <stdexec/execution.hpp>
+#include <vector>
+
+using namespace doca_stdexec;
+using namespace std::chrono_literals;
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+constexpr size_t message_size = 64;
+constexpr size_t flood_window = 1024;
+constexpr auto flood_task_cost = 500ns;
+constexpr size_t probes = 20000;
+
+void measure(const char* name, std::shared_ptr<Device> device, loop::run_loop_options options) {
+    bench::loopback pair{device, options};
+    bench::memory_pair memory{device, message_size};
+    auto& connection = *pair.connection;
+    auto scheduler = pair.context.get_scheduler();
+
+    bench::flood background{scheduler, flood_window, flood_task_cost};
+    auto before = pair.context.stats();
+    auto begin = clock_type::now();
+    background.start();
+
+    std::vector<double> latencies;
+    latencies.reserve(probes);
+    for (size_t i = 0; i < probes; i++) {
+        auto issued = clock_type::now();
+        // let_value so the DOCA task is allocated on the PE thread too
+        stdexec::sync_wait(stdexec::schedule(scheduler) |
+                           stdexec::let_value([&] { return memory.write_on(connection); }));
+        latencies.push_back(std::chrono::duration<double, std::micro>(clock_type::now() - issued).count());
+    }
+
+    auto flooded = background.stop();
+    auto elapsed = std::chrono::duration<double>(clock_type::now() - begin).count();
+    auto after = pair.context.stats();
+
+    std::ranges::sort(latencies);
+    auto percentile = [&](double p) { return latencies[static_cast<size_t>(p * (latencies.size() - 1))]; };
+    auto cut_short = (after.task_budget_exhausted - before.task_budget_exhausted) +
+                     (after.task_slice_exhausted - before.task_slice_exhausted);
+    printf("%-14s %10.1f %10.1f %10.1f %14.0f %10llu %10llu\n", name, percentile(0.5), percentile(0.99),
+           latencies.back(), static_cast<double>(flooded) / elapsed, static_cast<unsigned long long>(cut_short),
+           static_cast<unsigned long long>(after.passes - before.passes));
+}
+
+} // namespace
+
+int main() {
+    auto device = Device::open_from_ib_name(bench::device_name);
+
+    printf("%-14s %10s %10s %10s %14s %10s %10s\n", "budget", "p50 us", "p99 us", "max us", "flood tasks/s",
+           "cut short", "passes");
+
+    measure("4096 tasks", device, {.max_tasks_per_pass = 4096});
+    measure("256 tasks", device, {.max_tasks_per_pass = 256});
+    measure("32 tasks", device, {.max_tasks_per_pass = 32});
+    measure("20us slice", device, {.max_tasks_per_pass = 0, .time_slice = 20us});
+
+    return 0;
+}
@@ -0,0 +1,82 @@
+// Many low-rate tenants, each with its own ProgressEngine, on a thread per
+// tenant and multiplexed onto a few threads.
+//
+// The main thread pings the tenants in turn at a low rate: a ping is a
+// schedule() onto the tenant's loop, timed until sync_wait returns. CPU is
+// the process CPU time over the run divided by the wall time, i.e. the
+// number of cores kept busy.
+
+#include <doca_stdexec/multiplexer.hpp>
+#include <doca_stdexec/progress_engine.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <stdexec/execution.hpp>
+#include <sys/resource.h>
+#include <thread>
+#include <vector>
+
+using namespace doca_stdexec;
+using namespace std::chrono_literals;
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+constexpr size_t tenants = 64;
+constexpr size_t pings = 20000;
+constexpr auto ping_interval = 20us;
+
+double process_cpu_seconds() {
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    auto to_seconds = [](timeval tv) { return tv.tv_sec + tv.tv_usec * 1e-6; };
+    return to_seconds(usage.ru_utime) + to_seconds(usage.ru_stime);
+}
+
+template <typename GetScheduler>
+void measure(const char* name, GetScheduler get_scheduler) {
+    std::vector<double> latencies;
+    latencies.reserve(pings);
+
+    auto cpu_begin = process_cpu_seconds();
+    auto wall_begin = clock_type::now();
+    for (size_t i = 0; i < pings; i++) {
+        auto issued = clock_type::now();
+        stdexec::sync_wait(stdexec::schedule(get_scheduler(i % tenants)));
+        latencies.push_back(std::chrono::duration<double, std::micro>(clock_type::now() - issued).count());
+        std::this_thread::sleep_until(issued + ping_interval);
+    }
+    auto cores = (process_cpu_seconds() - cpu_begin) /
+                 std::chrono::duration<double>(clock_type::now() - wall_begin).count();
+
+    std::ranges::sort(latencies);
+    auto percentile = [&](double p) { return latencies[static_cast<size_t>(p * (latencies.size() - 1))]; };
+    printf("%-18s %10.1f %10.1f %10.1f %8.2f\n", name, percentile(0.5), percentile(0.99), latencies.back(), cores);
+}
+
+} // namespace
+
+int main() {
+    printf("%-18s %10s %10s %10s %8s\n", "mode", "p50 us", "p99 us", "max us", "cores");
+
+    {
+        loop::run_loop_options options{.mode = loop::progress_mode::adaptive, .spin_window = 50us};
+        std::vector<std::unique_ptr<doca_pe_context>> contexts;
+        for (size_t i = 0; i < tenants; i++) {
+            contexts.push_back(std::make_unique<doca_pe_context>(options));
+        }
+        measure("thread per tenant", [&](size_t i) { return contexts[i]->get_scheduler(); });
+    }
+
+    for (size_t threads : {1, 2, 4}) {
+        pe_multiplexer multiplexer{tenants, {.num_threads = threads, .idle_window = 50us}};
+        char name[32];
+        snprintf(name, sizeof(name), "multiplexed x%zu", threads);
+        measure(name, [&](size_t i) { return multiplexer.get_scheduler(i); });
+    }
+
+    return 0;
+}
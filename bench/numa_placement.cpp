@@ -0,0 +1,65 @@
+// RDMA write and read bandwidth with the PE thread and the registered
+// memory on the NIC's NUMA node versus on another node.
+
+#include "rdma_bench.hpp"
+
+#include <doca_stdexec/topology.hpp>
+
+#include <algorithm>
+#include <cstdio>
+
+using namespace doca_stdexec;
+
+namespace {
+
+constexpr size_t message_size = 64 * 1024;
+constexpr size_t window = 16;
+constexpr size_t operations = 1 << 15;
+
+void measure(const char* name, std::shared_ptr<Device> device, int node) {
+    pe_thread_options thread_options{.numa_node = node};
+    auto cpus = topology::prefer_isolated(topology::node_cpus(node));
+    if (!cpus.empty()) {
+        thread_options.cpu = cpus.front();
+    }
+
+    bench::loopback pair{device, {}, thread_options};
+    bench::memory_pair memory{device, message_size, node};
+    auto& connection = *pair.connection;
+
+    auto write_rate = bench::run_closed_loop(
+        pair.context.get_scheduler(), [&] { return memory.write_on(connection); }, window, operations);
+    auto read_rate = bench::run_closed_loop(
+        pair.context.get_scheduler(), [&] { return memory.read_on(connection); }, window, operations);
+
+    auto to_gbps = [](double rate) { return rate * message_size * 8 / 1e9; };
+    printf("%-8s %6d %6d %14.2f %14.2f\n", name, node, thread_options.cpu, to_gbps(write_rate), to_gbps(read_rate));
+}
+
+} // namespace
+
+int main() {
+    auto device = Device::open_from_ib_name(bench::device_name);
+    auto local = device->numa_node();
+    auto nodes = topology::online_nodes();
+
+    printf("device %s on numa node %d\n", device->pci_addr().c_str(), local);
+    printf("%-8s %6s %6s %14s %14s\n", "memory", "node", "cpu", "write Gbit/s", "read Gbit/s");
+
+    if (local < 0) {
+        printf("device numa node unknown, measuring default placement only\n");
+        measure("default", device, -1);
+        return 0;
+    }
+
+    measure("local", device, local);
+
+    auto remote = std::ranges::find_if(nodes, [&](int node) { return node != local; });
+    if (remote == nodes.end()) {
+        printf("single numa node, no remote placement to compare against\n");
+        return 0;
+    }
+    measure("remote", device, *remote);
+
+    return 0;
+}
@@ -0,0 +1,87 @@
+// Latency of pings from another thread to a PE thread saturated with bulk
+// tasks, for the priority classes of the run loop.
+//
+// The flood keeps a window of CPU-bound tasks rescheduling themselves on the
+// PE thread. A ping is a schedule() from the main thread, timed until it
+// runs on the PE thread and sync_wait returns. With both in one class the
+// ping waits behind whole passes of flood tasks; in a higher class it only
+// waits for the flood task currently running.
+
+#include "flood.hpp"
+
+#include <doca_stdexec/progress_engine.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <stdexec/execution.hpp>
+#include <vector>
+
+using namespace doca_stdexec;
+using namespace std::chrono_literals;
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+constexpr size_t flood_window = 1024;
+constexpr auto flood_task_cost = 2us;
+constexpr size_t pings = 5000;
+
+enum class ping_kind {
+    plain,
+    // schedule_before(now + deadline_slack) in the flood's class
+    deadline,
+};
+
+constexpr auto deadline_slack = 50us;
+
+void measure(const char* name, loop::run_loop_options options, priority flood_priority, priority ping_priority,
+             ping_kind kind = ping_kind::plain) {
+    doca_pe_context context{options};
+    auto ping_scheduler = context.get_scheduler(ping_priority);
+
+    bench::flood background{context.get_scheduler(flood_priority), flood_window, flood_task_cost};
+    auto before = context.stats();
+    auto begin = clock_type::now();
+    background.start();
+
+    std::vector<double> latencies;
+    latencies.reserve(pings);
+    for (size_t i = 0; i < pings; i++) {
+        auto issued = clock_type::now();
+        if (kind == ping_kind::deadline) {
+            stdexec::sync_wait(ping_scheduler.schedule_before(issued + deadline_slack));
+        } else {
+            stdexec::sync_wait(stdexec::schedule(ping_scheduler));
+        }
+        latencies.push_back(std::chrono::duration<double, std::micro>(clock_type::now() - issued).count());
+    }
+
+    auto flooded = background.stop();
+    auto elapsed = std::chrono::duration<double>(clock_type::now() - begin).count();
+    auto window = context.stats().since(before);
+
+    std::ranges::sort(latencies);
+    auto percentile = [&](double p) { return latencies[static_cast<size_t>(p * (latencies.size() - 1))]; };
+    printf("%-22s %10.1f %10.1f %10.1f %14.0f %10llu\n", name, percentile(0.5), percentile(0.99), latencies.back(),
+           static_cast<double>(flooded) / elapsed,
+           static_cast<unsigned long long>(window.tasks_by_priority[index_of(ping_priority)]));
+}
+
+} // namespace
+
+int main() {
+    printf("%-22s %10s %10s %10s %14s %10s\n", "mode", "p50 us", "p99 us", "max us", "flood tasks/s",
+           "ping class");
+
+    loop::run_loop_options strict{.dequeue_policy = loop::priority_policy::strict};
+    loop::run_loop_options weighted{.dequeue_policy = loop::priority_policy::weighted};
+
+    measure("same class", strict, priority::normal, priority::normal);
+    measure("high over low, strict", strict, priority::low, priority::high);
+    measure("high over low, weighted", weighted, priority::low, priority::high);
+    measure("deadline in class", strict, priority::normal, priority::normal, ping_kind::deadline);
+
+    return 0;
+}
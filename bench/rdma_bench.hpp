@@ -0,0 +1,271 @@
+#pragma once
+#ifndef DOCA_STDEXEC_BENCH_RDMA_BENCH_HPP
+#define DOCA_STDEXEC_BENCH_RDMA_BENCH_HPP
+
+// Shared helpers for the RDMA benchmarks. Like test/rdma_loopback.cpp they
+// run both peers in one process over the loopback of one device.
+
+#include <doca_stdexec/buf.hpp>
+#include <doca_stdexec/buf_inventory.hpp>
+#include <doca_stdexec/common/tcp.hpp>
+#include <doca_stdexec/mmap.hpp>
+#include <doca_stdexec/progress_engine.hpp>
+#include <doca_stdexec/rdma.hpp>
+#include <doca_stdexec/topology.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <optional>
+#include <stdexec/execution.hpp>
+#include <sys/socket.h>
+#include <utility>
+#include <vector>
+
+namespace bench {
+
+inline constexpr const char* device_name = "mlx5_0";
+inline constexpr uint32_t gid_index = 1;
+
+/**
+ * @brief Two connected sockets standing in for the out-of-band channel
+ */
+inline std::pair<doca_stdexec::tcp::tcp_socket, doca_stdexec::tcp::tcp_socket> socket_pair() {
+    int fds[2];
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) < 0) {
+        throw doca_stdexec::tcp::socket_error("Failed to create socket pair");
+    }
+    return {doca_stdexec::tcp::tcp_socket{fds[0]}, doca_stdexec::tcp::tcp_socket{fds[1]}};
+}
+
+/**
+ * @brief Two started Rdma contexts on their own PE threads, connected to each other
+ *
+ * `connection` is driven from `context`; `peer` only exists so the other end
+ * of the queue pair is live.
+ */
+struct loopback {
+    std::shared_ptr<doca_stdexec::Device> device;
+    doca_stdexec::doca_pe_context context;
+    doca_stdexec::doca_pe_context peer_context;
+    std::shared_ptr<doca_stdexec::rdma::Rdma> rdma;
+    std::shared_ptr<doca_stdexec::rdma::Rdma> peer_rdma;
+    std::optional<doca_stdexec::rdma::RdmaConnection> connection;
+    std::optional<doca_stdexec::rdma::RdmaConnection> peer;
+
+    explicit loopback(std::shared_ptr<doca_stdexec::Device> dev, doca_stdexec::loop::run_loop_options options = {},
+                      doca_stdexec::pe_thread_options thread_options = {})
+        : device(std::move(dev)), context(doca_stdexec::ProgressEngine{}, options, thread_options),
+          peer_context(doca_stdexec::ProgressEngine{}) {
+        rdma = start_rdma_(context);
+        peer_rdma = start_rdma_(peer_context);
+
+        auto [a, b] = socket_pair();
+        auto [local, remote] =
+            stdexec::sync_wait(stdexec::when_all(
+                                   stdexec::schedule(context.get_scheduler()) |
+                                       stdexec::let_value([&] { return rdma->connect(a); }),
+                                   stdexec::schedule(peer_context.get_scheduler()) |
+                                       stdexec::let_value([&] { return peer_rdma->connect(b); })))
+                .value();
+        connection.emplace(std::move(local));
+        peer.emplace(std::move(remote));
+    }
+
+    ~loopback() {
+        connection.reset();
+        peer.reset();
+        stdexec::sync_wait(stdexec::schedule(context.get_scheduler()) | stdexec::then([&] { rdma->stop(); }));
+        stdexec::sync_wait(stdexec::schedule(peer_context.get_scheduler()) |
+                           stdexec::then([&] { peer_rdma->stop(); }));
+    }
+
+private:
+    std::shared_ptr<doca_stdexec::rdma::Rdma> start_rdma_(doca_stdexec::doca_pe_context& ctx) {
+        auto r = doca_stdexec::rdma::Rdma::open_from_dev(device);
+        r->set_gid_index(gid_index);
+        stdexec::sync_wait(stdexec::schedule(ctx.get_scheduler()) | stdexec::then([&] {
+                               ctx.connect_ctx(r);
+                               r->start();
+                           }));
+        return r;
+    }
+};
+
+/**
+ * @brief A registered local buffer and a remote buffer it can be written to
+ */
+struct memory_pair {
+    doca_stdexec::topology::node_buffer<uint8_t> local_memory;
+    doca_stdexec::topology::node_buffer<uint8_t> remote_memory;
+    // stands in for the peer's registration of remote_memory
+    std::optional<doca_stdexec::MMap<uint8_t>> exported_mmap;
+    std::optional<doca_stdexec::MMap<uint8_t>> local_mmap;
+    std::optional<doca_stdexec::MMap<uint8_t>> remote_mmap;
+    doca_stdexec::BufInventory inventory{64};
+    // local to remote, for writes
+    doca_stdexec::Buf src;
+    doca_stdexec::Buf dst;
+    // remote to local, for reads
+    doca_stdexec::Buf remote_src;
+    doca_stdexec::Buf local_dst;
+
+    /**
+     * @param numa_node Node both buffers are allocated on, -1 for the default policy
+     */
+    memory_pair(std::shared_ptr<doca_stdexec::Device> device, size_t message_size, int numa_node = -1)
+        : local_memory(message_size, numa_node), remote_memory(message_size, numa_node) {
+        constexpr uint32_t permissions =
+            DOCA_ACCESS_FLAG_LOCAL_READ_WRITE | DOCA_ACCESS_FLAG_RDMA_READ | DOCA_ACCESS_FLAG_RDMA_WRITE;
+
+        local_mmap.emplace(local_memory.span());
+        local_mmap->add_device(device);
+        local_mmap->set_permissions(permissions);
+        local_mmap->start();
+
+        exported_mmap.emplace(remote_memory.span());
+        exported_mmap->add_device(device);
+        exported_mmap->set_permissions(permissions);
+        exported_mmap->start();
+        auto desc = exported_mmap->export_rdma(*device);
+
+        doca_data user_data{};
+        remote_mmap.emplace(doca_stdexec::MMap<uint8_t>::create_from_export(&user_data, desc.data(), desc.size(),
+                                                                             device));
+
+        inventory.start();
+        src = inventory.get_buffer_for_mmap(*local_mmap);
+        src.set_data_len(message_size);
+        dst = inventory.get_buffer_by_addr(*remote_mmap, remote_mmap->get_memrange().data(), message_size);
+        dst.set_data_len(0);
+
+        remote_src = inventory.get_buffer_by_addr(*remote_mmap, remote_mmap->get_memrange().data(), message_size);
+        remote_src.set_data_len(message_size);
+        local_dst = inventory.get_buffer_for_mmap(*local_mmap);
+        local_dst.set_data_len(0);
+    }
+
+    // DOCA appends to the destination's data segment, so every operation
+    // rewinds it and lands on the same bytes.
+
+    auto write_on(doca_stdexec::rdma::RdmaConnection& connection) {
+        dst.set_data_len(0);
+        return connection.write(src, dst);
+    }
+
+    auto read_on(doca_stdexec::rdma::RdmaConnection& connection) {
+        local_dst.set_data_len(0);
+        return connection.read(remote_src, local_dst);
+    }
+};
+
+/**
+ * @brief Keeps `window` senders from `factory` in flight until `total` complete
+ *
+ * Must be started on the PE thread that completes the senders; all
+ * bookkeeping then happens on that one thread.
+ */
+template <typename Factory>
+class closed_loop {
+    struct receiver {
+        using receiver_concept = stdexec::receiver_t;
+
+        closed_loop* loop;
+        size_t slot;
+
+        void set_value() noexcept {
+            loop->on_complete_(slot);
+        }
+
+        template <typename Error>
+        void set_error(Error&&) noexcept {
+            printf("closed_loop: operation failed\n");
+            std::abort();
+        }
+
+        void set_stopped() noexcept {
+            printf("closed_loop: operation stopped\n");
+            std::abort();
+        }
+
+        [[nodiscard]]
+        stdexec::env<> get_env() const noexcept {
+            return {};
+        }
+    };
+
+    using sender_t = std::invoke_result_t<Factory&>;
+    using op_t = stdexec::connect_result_t<sender_t, receiver>;
+
+    struct slot_storage {
+        alignas(op_t) std::byte bytes[sizeof(op_t)];
+    };
+
+public:
+    closed_loop(Factory factory, size_t window, size_t total)
+        : factory_(std::move(factory)), window_(window), total_(total), slots_(window) {}
+
+    void start() {
+        for (size_t slot = 0; slot < window_ && started_ < total_; slot++) {
+            start_slot_(slot);
+        }
+    }
+
+    bool done() const noexcept {
+        return done_.load(std::memory_order_acquire);
+    }
+
+    void wait() const noexcept {
+        while (!done()) {
+        }
+    }
+
+private:
+    op_t* op_(size_t slot) noexcept {
+        return std::launder(reinterpret_cast<op_t*>(slots_[slot].bytes));
+    }
+
+    void start_slot_(size_t slot) {
+        started_++;
+        auto* op = ::new (slots_[slot].bytes) op_t(stdexec::connect(factory_(), receiver{this, slot}));
+        stdexec::start(*op);
+    }
+
+    void on_complete_(size_t slot) noexcept {
+        op_(slot)->~op_t();
+        if (++completed_ == total_) {
+            done_.store(true, std::memory_order_release);
+        } else if (started_ < total_) {
+            start_slot_(slot);
+        }
+    }
+
+    Factory factory_;
+    size_t window_;
+    size_t total_;
+    size_t started_ = 0;
+    size_t completed_ = 0;
+    std::vector<slot_storage> slots_;
+    std::atomic<bool> done_ = false;
+};
+
+/**
+ * @brief Run a closed loop on `scheduler` and return the completion rate in ops/s
+ */
+template <typename Scheduler, typename Factory>
+double run_closed_loop(Scheduler scheduler, Factory factory, size_t window, size_t total) {
+    closed_loop<Factory> loop{std::move(factory), window, total};
+
+    auto begin = std::chrono::steady_clock::now();
+    stdexec::sync_wait(stdexec::schedule(scheduler) | stdexec::then([&] { loop.start(); }));
+    loop.wait();
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+    return static_cast<double>(total) / elapsed;
+}
+
+} // namespace bench
+
+#endif // DOCA_STDEXEC_BENCH_RDMA_BENCH_HPP
@@ -0,0 +1,96 @@
+// Scheduling throughput onto one PE thread with 1..64 producer threads.
+//
+// Every producer keeps a window of preallocated schedule operations in
+// flight, so the numbers measure the run loop queue and not the allocator.
+
+#include <doca_stdexec/progress_engine.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <new>
+#include <stdexec/execution.hpp>
+#include <thread>
+#include <vector>
+
+using namespace doca_stdexec;
+
+namespace {
+
+constexpr size_t window = 256;
+constexpr size_t ops_per_producer = 1 << 18;
+
+struct counting_receiver {
+    using receiver_concept = stdexec::receiver_t;
+
+    std::atomic<size_t>* completed;
+
+    void set_value() noexcept {
+        completed->fetch_add(1, std::memory_order_release);
+    }
+
+    void set_error(std::exception_ptr) noexcept {
+        std::terminate();
+    }
+
+    void set_stopped() noexcept {
+        std::terminate();
+    }
+
+    [[nodiscard]]
+    stdexec::env<> get_env() const noexcept {
+        return {};
+    }
+};
+
+using scheduler_t = decltype(std::declval<doca_pe_context&>().get_scheduler());
+using op_t = stdexec::connect_result_t<decltype(std::declval<scheduler_t>().schedule()), counting_receiver>;
+
+struct alignas(cache_line_size) producer_state {
+    std::atomic<size_t> completed{0};
+};
+
+void produce(scheduler_t scheduler, producer_state& state) {
+    auto storage = std::make_unique<std::byte[]>(sizeof(op_t) * window);
+    auto* ops = reinterpret_cast<op_t*>(storage.get());
+
+    for (size_t issued = 0; issued < ops_per_producer; issued += window) {
+        for (size_t i = 0; i < window; i++) {
+            auto* op = ::new (&ops[i]) op_t(stdexec::connect(scheduler.schedule(), counting_receiver{&state.completed}));
+            stdexec::start(*op);
+        }
+        while (state.completed.load(std::memory_order_acquire) < issued + window) {
+        }
+        for (size_t i = 0; i < window; i++) {
+            ops[i].~op_t();
+        }
+    }
+}
+
+} // namespace
+
+int main() {
+    doca_pe_context context{};
+
+    printf("%10s %16s %12s\n", "producers", "ops/s", "ns/op");
+
+    for (size_t producers = 1; producers <= 64; producers *= 2) {
+        std::vector<producer_state> states(producers);
+        std::vector<std::thread> threads;
+
+        auto begin = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < producers; i++) {
+            threads.emplace_back(produce, context.get_scheduler(), std::ref(states[i]));
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+        auto total = static_cast<double>(producers * ops_per_producer);
+        printf("%10zu %16.0f %12.1f\n", producers, total / elapsed, elapsed * 1e9 / total);
+    }
+
+    return 0;
+}
@@ -0,0 +1,82 @@
+// RDMA write message rate as a function of the number of shards.
+//
+// One connection per shard; every shard drives its own connection from its
+// own PE thread, so the rate should scale until the NIC saturates.
+
+#include "rdma_bench.hpp"
+
+#include <doca_stdexec/sharded_context.hpp>
+
+#include <cstdio>
+#include <optional>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+using namespace doca_stdexec;
+
+namespace {
+
+constexpr size_t message_size = 64;
+constexpr size_t window = 64;
+constexpr size_t writes_per_shard = 1 << 20;
+
+double measure(std::shared_ptr<Device> device, size_t num_shards) {
+    sharded_context_options options{
+        .num_shards = num_shards,
+        .configure_rdma = [](rdma::Rdma& rdma) { rdma.set_gid_index(bench::gid_index); },
+    };
+    sharded_pe_context server{device, options};
+    sharded_pe_context client{device, options};
+
+    std::vector<shard_connection> connections;
+    std::vector<shard_connection> peers;
+    std::vector<std::unique_ptr<bench::memory_pair>> memory;
+
+    for (size_t i = 0; i < num_shards; i++) {
+        auto [a, b] = bench::socket_pair();
+        // connect_on exchanges the descriptors before it returns, so the
+        // two ends have to run at once
+        std::optional<shard_connection> peer;
+        std::thread peer_side([&] { peer = std::get<0>(stdexec::sync_wait(client.connect_on(i, b)).value()); });
+        auto [connection] = stdexec::sync_wait(server.connect_on(i, a)).value();
+        peer_side.join();
+        connections.push_back(std::move(connection));
+        peers.push_back(std::move(*peer));
+        memory.push_back(std::make_unique<bench::memory_pair>(device, message_size));
+    }
+
+    std::vector<double> rates(num_shards);
+    std::vector<std::thread> drivers;
+    for (size_t i = 0; i < num_shards; i++) {
+        drivers.emplace_back([&, i] {
+            auto& connection = connections[i];
+            auto& mem = *memory[i];
+            rates[i] = bench::run_closed_loop(
+                connection.scheduler, [&] { return mem.write_on(connection.connection); }, window, writes_per_shard);
+        });
+    }
+    for (auto& driver : drivers) {
+        driver.join();
+    }
+
+    double total = 0;
+    for (auto rate : rates) {
+        total += rate;
+    }
+    return total;
+}
+
+} // namespace
+
+int main() {
+    auto device = Device::open_from_ib_name(bench::device_name);
+
+    printf("%8s %16s %16s\n", "shards", "writes/s", "per shard");
+    for (size_t shards = 1; shards <= 8; shards *= 2) {
+        auto rate = measure(device, shards);
+        printf("%8zu %16.0f %16.0f\n", shards, rate, rate / static_cast<double>(shards));
+    }
+
+    return 0;
+}
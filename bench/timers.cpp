@@ -0,0 +1,153 @@
+// Accuracy and cost of run loop timers.
+//
+// Accuracy is the lateness of schedule_after() completions against their
+// deadline in the spin and adaptive modes. Cost is the time to arm and to
+// cancel 100k timers, and the plain schedule() rate of the PE thread with
+// and without those 100k timers armed.
+
+#include "rdma_bench.hpp"
+
+#include <doca_stdexec/progress_engine.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <new>
+#include <random>
+#include <stdexec/execution.hpp>
+#include <vector>
+
+using namespace doca_stdexec;
+using namespace std::chrono_literals;
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+constexpr size_t accuracy_samples = 1000;
+constexpr size_t armed_timers = 100'000;
+constexpr size_t schedule_window = 256;
+constexpr size_t schedule_ops = 1 << 22;
+
+void measure_accuracy(const char* name, loop::run_loop_options options, std::chrono::microseconds delay) {
+    doca_pe_context context{options};
+    auto scheduler = context.get_scheduler();
+
+    std::vector<double> lateness;
+    lateness.reserve(accuracy_samples);
+    for (size_t i = 0; i < accuracy_samples; i++) {
+        auto deadline = clock_type::now() + delay;
+        auto [fired] = stdexec::sync_wait(scheduler.schedule_at(deadline) |
+                                          stdexec::then([] { return clock_type::now(); }))
+                           .value();
+        lateness.push_back(std::chrono::duration<double, std::micro>(fired - deadline).count());
+    }
+
+    std::ranges::sort(lateness);
+    auto percentile = [&](double p) { return lateness[static_cast<size_t>(p * (lateness.size() - 1))]; };
+    printf("%-10s %10lld %10.2f %10.2f %10.2f\n", name, static_cast<long long>(delay.count()), percentile(0.5),
+           percentile(0.99), lateness.back());
+}
+
+struct timer_receiver {
+    using receiver_concept = stdexec::receiver_t;
+
+    stdexec::inplace_stop_token token;
+    size_t* fired;
+    size_t* stopped;
+
+    void set_value() noexcept {
+        ++*fired;
+    }
+
+    void set_stopped() noexcept {
+        ++*stopped;
+    }
+
+    [[nodiscard]]
+    auto get_env() const noexcept {
+        return stdexec::prop{stdexec::get_stop_token, token};
+    }
+};
+
+using scheduler_t = decltype(std::declval<doca_pe_context&>().get_scheduler());
+using timer_op_t = stdexec::connect_result_t<decltype(std::declval<scheduler_t>().schedule_after(1s)), timer_receiver>;
+
+void measure_overhead() {
+    doca_pe_context context{};
+    auto scheduler = context.get_scheduler();
+    auto on_pe = [&](auto fn) { stdexec::sync_wait(stdexec::schedule(scheduler) | stdexec::then(fn)); };
+
+    auto baseline = bench::run_closed_loop(
+        scheduler, [&] { return stdexec::schedule(scheduler); }, schedule_window, schedule_ops);
+
+    // deadlines spread over 2..12s so none fires during the measurement
+    std::mt19937_64 rng{42};
+    std::uniform_int_distribution<int64_t> delay_us{2'000'000, 12'000'000};
+    std::vector<clock_type::time_point> deadlines(armed_timers);
+    auto now = clock_type::now();
+    for (auto& deadline : deadlines) {
+        deadline = now + std::chrono::microseconds(delay_us(rng));
+    }
+
+    stdexec::inplace_stop_source stop_source;
+    size_t fired = 0;
+    size_t stopped = 0;
+    auto storage = std::make_unique<std::byte[]>(sizeof(timer_op_t) * armed_timers);
+    auto* ops = reinterpret_cast<timer_op_t*>(storage.get());
+
+    // started on the PE thread, so arming does not include the hop
+    auto arm_begin = clock_type::now();
+    on_pe([&] {
+        for (size_t i = 0; i < armed_timers; i++) {
+            auto* op = ::new (&ops[i]) timer_op_t(stdexec::connect(
+                scheduler.schedule_at(deadlines[i]), timer_receiver{stop_source.get_token(), &fired, &stopped}));
+            stdexec::start(*op);
+        }
+    });
+    // the arm tasks queued above run after the sync_wait continuation
+    on_pe([] {});
+    auto arm_elapsed = clock_type::now() - arm_begin;
+
+    auto loaded = bench::run_closed_loop(
+        scheduler, [&] { return stdexec::schedule(scheduler); }, schedule_window, schedule_ops);
+
+    auto cancel_begin = clock_type::now();
+    stop_source.request_stop();
+    on_pe([] {});
+    auto cancel_elapsed = clock_type::now() - cancel_begin;
+
+    size_t fired_total = 0;
+    size_t stopped_total = 0;
+    on_pe([&] {
+        fired_total = fired;
+        stopped_total = stopped;
+    });
+    for (size_t i = 0; i < armed_timers; i++) {
+        ops[i].~timer_op_t();
+    }
+
+    auto per_timer = [](clock_type::duration elapsed) {
+        return std::chrono::duration<double, std::nano>(elapsed).count() / armed_timers;
+    };
+    printf("\n%zu timers: arm %.1f ns/timer, cancel %.1f ns/timer (%zu fired, %zu stopped)\n", armed_timers,
+           per_timer(arm_elapsed), per_timer(cancel_elapsed), fired_total, stopped_total);
+    printf("%-16s %16s\n", "timers armed", "schedule ops/s");
+    printf("%-16d %16.0f\n", 0, baseline);
+    printf("%-16zu %16.0f\n", armed_timers, loaded);
+}
+
+} // namespace
+
+int main() {
+    printf("%-10s %10s %10s %10s %10s\n", "mode", "delay us", "p50 us", "p99 us", "max us");
+    for (auto delay : {10us, 100us, 1000us}) {
+        measure_accuracy("spin", {.mode = loop::progress_mode::spin}, delay);
+        measure_accuracy("adaptive", {.mode = loop::progress_mode::adaptive, .spin_window = 100us}, delay);
+    }
+
+    measure_overhead();
+
+    return 0;
+}
@@ -0,0 +1,65 @@
+// RDMA write round trips with tracing compiled in, written out as a Chrome
+// trace for ui.perfetto.dev.
+//
+// Every write shows up as a "task" slice on the PE thread for the hop that
+// allocates and submits it, an async "doca task" slice from submit to
+// completion, and a "receiver" slice for the delivery. The printed latency
+// is the same loop as the mixed_load probe without the flood, so comparing
+// it with a build without tracing shows what the events cost.
+
+#ifndef DOCA_STDEXEC_TRACE
+#define DOCA_STDEXEC_TRACE
+#endif
+
+#include "rdma_bench.hpp"
+
+#include <doca_stdexec/trace.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <stdexec/execution.hpp>
+#include <vector>
+
+using namespace doca_stdexec;
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+constexpr size_t message_size = 64;
+constexpr size_t writes = 10000;
+constexpr const char* trace_path = "trace_write.json";
+
+} // namespace
+
+int main() {
+    auto device = Device::open_from_ib_name(bench::device_name);
+    bench::loopback pair{device};
+    bench::memory_pair memory{device, message_size};
+    auto& connection = *pair.connection;
+    auto scheduler = pair.context.get_scheduler();
+
+    trace::set_thread_name("main");
+
+    std::vector<double> latencies;
+    latencies.reserve(writes);
+    for (size_t i = 0; i < writes; i++) {
+        auto issued = clock_type::now();
+        stdexec::sync_wait(stdexec::schedule(scheduler) |
+                           stdexec::let_value([&] { return memory.write_on(connection); }));
+        latencies.push_back(std::chrono::duration<double, std::micro>(clock_type::now() - issued).count());
+    }
+
+    std::ranges::sort(latencies);
+    auto percentile = [&](double p) { return latencies[static_cast<size_t>(p * (latencies.size() - 1))]; };
+    printf("%10s %10s %10s\n", "p50 us", "p99 us", "max us");
+    printf("%10.1f %10.1f %10.1f\n", percentile(0.5), percentile(0.99), latencies.back());
+
+    if (!trace::write_chrome_trace(trace_path)) {
+        printf("failed to write %s\n", trace_path);
+        return 1;
+    }
+    printf("trace written to %s\n", trace_path);
+    return 0;
+}
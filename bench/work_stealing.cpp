@@ -0,0 +1,99 @@
+// Latency of light tasks on a PE thread while it receives a burst of
+// expensive continuations, with and without work stealing.
+//
+// In the inline mode the burst runs on the PE thread itself and every probe
+// waits behind it. In the stealing mode the burst is scheduled as stealable,
+// so the idle PE threads and helper threads of the group take it over.
+
+#include <doca_stdexec/progress_engine.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <exec/async_scope.hpp>
+#include <memory>
+#include <stdexec/execution.hpp>
+#include <thread>
+#include <vector>
+
+using namespace doca_stdexec;
+using namespace std::chrono_literals;
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+constexpr size_t num_contexts = 4;
+constexpr size_t num_helpers = 2;
+constexpr size_t burst_size = 512;
+constexpr auto burst_task_cost = 200us;
+
+void busy_for(std::chrono::microseconds duration) {
+    auto end = clock_type::now() + duration;
+    while (clock_type::now() < end) {
+    }
+}
+
+void measure(const char* name, bool stealing) {
+    work_stealing_group group;
+    std::vector<std::unique_ptr<doca_pe_context>> contexts;
+    for (size_t i = 0; i < num_contexts; i++) {
+        contexts.push_back(std::make_unique<doca_pe_context>());
+        if (stealing) {
+            contexts.back()->join_work_stealing_group(group);
+        }
+    }
+    if (stealing) {
+        group.start_helpers(num_helpers);
+    }
+
+    auto& victim = *contexts.front();
+    auto burst_scheduler = stealing ? victim.get_stealable_scheduler() : victim.get_scheduler();
+
+    exec::async_scope scope;
+    auto burst_begin = clock_type::now();
+    for (size_t i = 0; i < burst_size; i++) {
+        scope.spawn(stdexec::schedule(victim.get_scheduler()) | stdexec::continues_on(burst_scheduler) |
+                    stdexec::then([] { busy_for(burst_task_cost); }));
+    }
+
+    std::vector<double> latencies;
+    std::atomic<bool> burst_done = false;
+    std::thread waiter([&] {
+        stdexec::sync_wait(scope.on_empty());
+        burst_done.store(true);
+    });
+
+    while (!burst_done.load()) {
+        auto scheduled = clock_type::now();
+        auto [ran] =
+            stdexec::sync_wait(stdexec::schedule(victim.get_scheduler()) | stdexec::then([] { return clock_type::now(); }))
+                .value();
+        latencies.push_back(std::chrono::duration<double, std::micro>(ran - scheduled).count());
+        std::this_thread::sleep_for(100us);
+    }
+    waiter.join();
+    auto burst_elapsed = std::chrono::duration<double, std::milli>(clock_type::now() - burst_begin).count();
+
+    std::ranges::sort(latencies);
+    auto percentile = [&](double p) { return latencies[static_cast<size_t>(p * (latencies.size() - 1))]; };
+
+    printf("%-10s %12.1f %10.1f %10.1f %10.1f %8zu\n", name, burst_elapsed, percentile(0.5), percentile(0.99),
+           latencies.back(), latencies.size());
+
+    group.stop_helpers();
+    // contexts are destroyed before the group they joined
+    contexts.clear();
+}
+
+} // namespace
+
+int main() {
+    printf("%-10s %12s %10s %10s %10s %8s\n", "mode", "burst ms", "p50 us", "p99 us", "max us", "probes");
+
+    measure("inline", false);
+    measure("stealing", true);
+
+    return 0;
+}
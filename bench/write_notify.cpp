@@ -0,0 +1,75 @@
+// Rate of writes that notify the peer: a write followed by a send, against
+// one write with immediate. Both consume one receive posted by the peer,
+// which keeps `window` receives outstanding on its own PE thread.
+
+#include "rdma_bench.hpp"
+
+#include <cstdio>
+#include <stdexec/execution.hpp>
+#include <vector>
+
+using namespace doca_stdexec;
+
+namespace {
+
+constexpr size_t message_size = 8;
+constexpr size_t window = 16;
+constexpr size_t total = 1000000;
+
+/**
+ * @brief Posts `total` receives on the peer, `window` at a time, into
+ *        buffers of their own
+ */
+struct receiver_side {
+    std::vector<Buf> buffers;
+    size_t next = 0;
+
+    explicit receiver_side(bench::memory_pair& memory) {
+        auto* local = memory.local_mmap->get_memrange().data();
+        for (size_t i = 0; i < window; i++) {
+            buffers.push_back(
+                memory.inventory.get_buffer_by_addr(*memory.local_mmap, local + (i + 1) * message_size, message_size));
+        }
+    }
+
+    template <typename Notify>
+    double run(bench::loopback& pair, Notify notify) {
+        auto post = [&] {
+            auto& buf = buffers[next++ % window];
+            buf.set_data_len(0);
+            return pair.peer_rdma->recv(buf) | stdexec::then([](rdma::receive_result) {});
+        };
+        bench::closed_loop<decltype(post)> receives{post, window, total};
+        stdexec::sync_wait(stdexec::schedule(pair.peer_context.get_scheduler()) |
+                           stdexec::then([&] { receives.start(); }));
+
+        auto rate = bench::run_closed_loop(pair.context.get_scheduler(), notify, window, total);
+        receives.wait();
+        return rate;
+    }
+};
+
+} // namespace
+
+int main() {
+    auto device = Device::open_from_ib_name(bench::device_name);
+    bench::loopback pair{device};
+    // the first slot is written, the others receive
+    bench::memory_pair memory{device, message_size * (window + 1)};
+    auto& connection = *pair.connection;
+    receiver_side peer{memory};
+
+    printf("%-12s %14s\n", "notify", "writes/s");
+
+    uint32_t sequence = 0;
+    printf("%-12s %14.0f\n", "write+send", peer.run(pair, [&] {
+        return memory.write_on(connection) | stdexec::let_value([&] { return connection.send(memory.src); });
+    }));
+
+    printf("%-12s %14.0f\n", "write_imm", peer.run(pair, [&] {
+        memory.dst.set_data_len(0);
+        return connection.write_imm(memory.src, memory.dst, sequence++);
+    }));
+
+    return 0;
+}
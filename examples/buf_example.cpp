@@ -38,7 +38,8 @@ void demonstrate_buffer_operations() {
         std::cout << "\n3. List Operations:\n";
         std::cout << "   - Check if in list: buffer.is_in_list()\n";
         std::cout << "   - Get list length: buffer.get_list_len()\n";
-        std::cout << "   - Collect all buffers: buffer.collect_list()\n";
+        std::cout << "   - Iterate the list: for (doca_buf* part : buffer.chain())\n";
+        std::cout << "   - Build a list: gather_list{header}.append(payload).build()\n";
         
         // Example 4: Template operations
         std::cout << "\n4. Type-safe Operations:\n";
@@ -65,10 +66,11 @@ void demonstrate_list_traversal() {
     // Conceptual example of traversing a buffer list
     std::cout << "Traversing buffer list:\n";
     std::cout << R"(
-    auto buffers = head_buffer.collect_list();
-    for (const auto& buf : buffers) {
-        std::cout << "Buffer data length: " << buf.get_data_len() << std::endl;
-        auto data_span = buf.get_data_span();
+    // no allocation and no reference counts touched
+    for (doca_buf* part : head_buffer.chain()) {
+        size_t data_len;
+        doca_buf_get_data_len(part, &data_len);
+        std::cout << "Buffer data length: " << data_len << std::endl;
         // Process buffer data...
     }
     
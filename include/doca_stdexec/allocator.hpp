@@ -0,0 +1,78 @@
+#pragma once
+#ifndef DOCA_STDEXEC_ALLOCATOR_HPP
+#define DOCA_STDEXEC_ALLOCATOR_HPP
+
+#include "doca_stdexec/frame_pool.hpp"
+#include <cstddef>
+#include <new>
+#include <stdexec/execution.hpp>
+
+namespace doca_stdexec {
+
+/**
+ * @brief Allocator drawing from the frame pool of the calling PE thread
+ *
+ * Stateless, so any two compare equal and a block may be freed on any
+ * thread; off a PE thread it allocates from the heap.
+ */
+template <typename T>
+class pool_allocator {
+public:
+    using value_type = T;
+
+    pool_allocator() noexcept = default;
+
+    template <typename U>
+    pool_allocator(const pool_allocator<U>&) noexcept {}
+
+    T* allocate(size_t n) {
+        if constexpr (alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+            return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{alignof(T)}));
+        } else {
+            return static_cast<T*>(frame_pool::allocate(n * sizeof(T)));
+        }
+    }
+
+    void deallocate(T* p, size_t) noexcept {
+        if constexpr (alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+            ::operator delete(p, std::align_val_t{alignof(T)});
+        } else {
+            frame_pool::deallocate(p);
+        }
+    }
+
+    template <typename U>
+    bool operator==(const pool_allocator<U>&) const noexcept {
+        return true;
+    }
+};
+
+/**
+ * @brief Environment whose get_allocator is a pool_allocator
+ *
+ * Passed to start_detached, the operation state of the spawned sender,
+ * RDMA operation and adaptors included, is allocated from the pool of the
+ * PE thread it is started on:
+ *
+ *   stdexec::start_detached(connection.write(src, dst), pool_env{});
+ */
+struct pool_env {
+    auto query(stdexec::get_allocator_t) const noexcept -> pool_allocator<std::byte> {
+        return {};
+    }
+};
+
+/**
+ * @brief start_detached with the operation state taken from the PE thread's pool
+ *
+ * Fire-and-forget traffic started from PE tasks and completions recycles
+ * its operation states instead of going to malloc for each one.
+ */
+template <stdexec::sender Sender>
+void spawn_detached(Sender&& sndr) {
+    stdexec::start_detached(static_cast<Sender&&>(sndr), pool_env{});
+}
+
+} // namespace doca_stdexec
+
+#endif // DOCA_STDEXEC_ALLOCATOR_HPP
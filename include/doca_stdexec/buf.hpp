@@ -1,5 +1,6 @@
 #pragma once
 #include "doca_stdexec/common.hpp"
+#include "doca_stdexec/trace.hpp"
 #ifndef DOCA_STDEXEC_BUF_HPP
 #define DOCA_STDEXEC_BUF_HPP
 
@@ -7,6 +8,7 @@
 #include <cstdint>
 #include <doca_buf.h>
 #include <doca_error.h>
+#include <limits>
 #include <span>
 #include <stdexcept>
 #include <vector>
@@ -30,6 +32,64 @@ private:
     doca_error_t error_code;
 };
 
+/**
+ * @brief The buffers of a doca_buf list, head first
+ *
+ * Walks the list with doca_buf_get_next_in_list and hands out the raw
+ * buffers: nothing is allocated and no reference count changes, so the
+ * list must outlive the iteration.
+ *
+ *   for (doca_buf* part : message.chain()) { ... }
+ */
+class buf_chain {
+public:
+    class iterator {
+    public:
+        using value_type = doca_buf*;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() = default;
+        explicit iterator(doca_buf* buf) noexcept : buf_(buf) {}
+
+        doca_buf* operator*() const noexcept {
+            return buf_;
+        }
+
+        iterator& operator++() noexcept {
+            doca_buf* next = nullptr;
+            if (doca_buf_get_next_in_list(buf_, &next) != DOCA_SUCCESS) {
+                next = nullptr;
+            }
+            buf_ = next;
+            return *this;
+        }
+
+        iterator operator++(int) noexcept {
+            auto it = *this;
+            ++*this;
+            return it;
+        }
+
+        bool operator==(const iterator&) const = default;
+
+    private:
+        doca_buf* buf_ = nullptr;
+    };
+
+    explicit buf_chain(doca_buf* head) noexcept : head_(head) {}
+
+    iterator begin() const noexcept {
+        return iterator{head_};
+    }
+
+    iterator end() const noexcept {
+        return {};
+    }
+
+private:
+    doca_buf* head_;
+};
+
 /**
  * @brief RAII wrapper for DOCA Buffer functionality
  *
@@ -452,9 +512,18 @@ public:
 
     // Utility functions
 
+    /**
+     * @brief The buffers of the list this buffer heads, without copying or
+     *        touching reference counts
+     */
+    [[nodiscard]] buf_chain chain() const noexcept {
+        return buf_chain{buf_};
+    }
+
     /**
      * @brief Collect all buffers in the list into a vector
      */
+    [[deprecated("allocates and wraps every element; iterate chain() instead")]]
     std::vector<Buf> collect_list() const {
         std::vector<Buf> result;
         if (!buf_) {
@@ -481,16 +550,72 @@ private:
         if (buf_) {
             uint16_t refcount;
             auto err = doca_buf_dec_refcount(buf_, &refcount);
-            printf("Decrementing buf refcount %d\n", refcount);
             check_error(err, "Failed to decrement buf refcount");
-            if (refcount == 1) {
-                printf("Destroying buf\n");
-            }
+            DOCA_STDEXEC_TRACE_EVENT(buf_release, buf_, refcount);
         }
         buf_ = nullptr;
     }
 };
 
+/**
+ * @brief Builds a doca_buf list to write or send from, e.g. a header and a
+ *        payload in separate buffers, without copying either
+ *
+ *   auto message = gather_list{std::move(header)}.append(std::move(payload)).build();
+ *   connection.send(message);
+ *
+ * Each part, itself a buffer or a list, is appended in O(1) and is owned
+ * by the list from then on: releasing the head releases it.
+ */
+class gather_list {
+public:
+    /**
+     * @param max_parts Longest list the list is for, e.g.
+     *        Rdma::max_send_gather_len(); appending beyond it throws
+     */
+    explicit gather_list(Buf head, uint32_t max_parts = std::numeric_limits<uint32_t>::max())
+        : head_(std::move(head)), tail_(head_.get_last_in_list().release()), size_(head_.get_list_len()),
+          max_parts_(max_parts) {
+        check_size_(0);
+    }
+
+    gather_list& append(Buf part) & {
+        auto parts = part.get_list_len();
+        check_size_(parts);
+        auto* last = part.get_last_in_list().release();
+        auto result = doca_buf_chain_list_tail(head_.get(), tail_, part.get());
+        check_error(result, "chain lists with tail");
+        part.release();
+        tail_ = last;
+        size_ += parts;
+        return *this;
+    }
+
+    gather_list&& append(Buf part) && {
+        return std::move(append(std::move(part)));
+    }
+
+    [[nodiscard]] uint32_t size() const noexcept {
+        return size_;
+    }
+
+    [[nodiscard]] Buf build() && {
+        return std::move(head_);
+    }
+
+private:
+    void check_size_(uint32_t parts) const {
+        if (parts > max_parts_ || size_ > max_parts_ - parts) {
+            throw BufException(DOCA_ERROR_TOO_BIG, "Gather list longer than supported");
+        }
+    }
+
+    Buf head_;
+    doca_buf* tail_;
+    uint32_t size_;
+    uint32_t max_parts_;
+};
+
 } // namespace doca_stdexec
 
 #endif // DOCA_STDEXEC_BUF_HPP
\ No newline at end of file
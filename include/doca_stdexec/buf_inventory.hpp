@@ -3,6 +3,7 @@
 #include "buf.hpp"
 #include "common.hpp"
 #include "mmap.hpp"
+#include "trace.hpp"
 #include <cstddef>
 #include <cstdint>
 #include <cstdio>
@@ -126,7 +127,7 @@ public:
                                                   len, &buf);
     check_error(err, "Failed to get buffer by address (addr=%p, len=%zu)", addr,
                 len);
-    printf("get_buffer_by_addr: buf %p\n", buf);
+    DOCA_STDEXEC_TRACE_EVENT(buf_lookup, buf, len);
     return Buf(buf);
   }
 
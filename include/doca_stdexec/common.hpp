@@ -4,6 +4,7 @@
 #ifndef DOCA_STDEXEC_COMMON_HPP
 #define DOCA_STDEXEC_COMMON_HPP
 #include <doca_error.h>
+#include <stdexcept>
 
 #if defined(__has_feature)
 #   if __has_feature(address_sanitizer) // for clang
@@ -35,5 +36,20 @@ inline void check_error(doca_error_t err, const char *msg, Args... args) {
   }
 }
 
+/**
+ * @brief A DOCA error surfaced as an exception, e.g. at a co_await or by
+ *        sync_wait on a sender that completed with set_error(doca_error_t)
+ */
+class doca_failure : public std::runtime_error {
+public:
+  explicit doca_failure(doca_error_t error)
+      : std::runtime_error(doca_error_get_name(error)), error_(error) {}
+
+  [[nodiscard]] doca_error_t error() const noexcept { return error_; }
+
+private:
+  doca_error_t error_;
+};
+
 } // namespace doca_stdexec
 #endif
\ No newline at end of file
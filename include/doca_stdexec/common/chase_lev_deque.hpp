@@ -0,0 +1,157 @@
+#pragma once
+#ifndef DOCA_STDEXEC_COMMON_CHASE_LEV_DEQUE_HPP
+#define DOCA_STDEXEC_COMMON_CHASE_LEV_DEQUE_HPP
+
+#include "doca_stdexec/common/mpsc_queue.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace doca_stdexec {
+
+/**
+ * @brief Chase-Lev work-stealing deque of pointers
+ *
+ * The owner pushes and pops at the bottom, any thread may steal from the
+ * top. Memory orderings follow Lê et al., "Correct and Efficient
+ * Work-Stealing for Weak Memory Models" (PPoPP 2013). The ring grows on
+ * demand; retired rings are kept until the deque is destroyed because a
+ * thief may still be reading from them.
+ *
+ * @tparam T Element type, the deque stores T*
+ */
+template <typename T>
+class chase_lev_deque {
+    struct ring {
+        explicit ring(int64_t capacity) : mask(capacity - 1), slots(new std::atomic<T*>[capacity]) {}
+
+        int64_t capacity() const noexcept {
+            return mask + 1;
+        }
+
+        T* get(int64_t index) const noexcept {
+            return slots[index & mask].load(std::memory_order_relaxed);
+        }
+
+        void put(int64_t index, T* item) noexcept {
+            slots[index & mask].store(item, std::memory_order_relaxed);
+        }
+
+        int64_t mask;
+        std::unique_ptr<std::atomic<T*>[]> slots;
+    };
+
+public:
+    /**
+     * @param capacity Initial capacity, must be a power of two
+     */
+    explicit chase_lev_deque(int64_t capacity = 256) {
+        rings_.push_back(std::make_unique<ring>(capacity));
+        ring_.store(rings_.back().get(), std::memory_order_relaxed);
+    }
+
+    chase_lev_deque(const chase_lev_deque&) = delete;
+    chase_lev_deque& operator=(const chase_lev_deque&) = delete;
+
+    /**
+     * @brief Push at the bottom, owner thread only
+     */
+    void push(T* item) {
+        int64_t bottom = bottom_.load(std::memory_order_relaxed);
+        int64_t top = top_.load(std::memory_order_acquire);
+        ring* r = ring_.load(std::memory_order_relaxed);
+
+        if (bottom - top > r->capacity() - 1) {
+            r = grow_(r, bottom, top);
+        }
+
+        r->put(bottom, item);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom_.store(bottom + 1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Pop the most recently pushed item, owner thread only
+     * @return The item, or nullptr if the deque is empty
+     */
+    T* pop() noexcept {
+        int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+        ring* r = ring_.load(std::memory_order_relaxed);
+        bottom_.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t top = top_.load(std::memory_order_relaxed);
+
+        if (top > bottom) {
+            bottom_.store(bottom + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        T* item = r->get(bottom);
+        if (top == bottom) {
+            // last item, race the thieves for it
+            if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                item = nullptr;
+            }
+            bottom_.store(bottom + 1, std::memory_order_relaxed);
+        }
+        return item;
+    }
+
+    /**
+     * @brief Steal the oldest item, callable from any thread
+     * @return The item, or nullptr if the deque is empty or the steal lost a race
+     */
+    T* steal() noexcept {
+        int64_t top = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t bottom = bottom_.load(std::memory_order_acquire);
+
+        if (top >= bottom) {
+            return nullptr;
+        }
+
+        ring* r = ring_.load(std::memory_order_acquire);
+        T* item = r->get(top);
+        if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            return nullptr;
+        }
+        return item;
+    }
+
+    /**
+     * @brief Approximate number of items, exact on the owner thread
+     */
+    int64_t size() const noexcept {
+        int64_t bottom = bottom_.load(std::memory_order_relaxed);
+        int64_t top = top_.load(std::memory_order_relaxed);
+        return bottom > top ? bottom - top : 0;
+    }
+
+    bool empty() const noexcept {
+        return size() == 0;
+    }
+
+private:
+    ring* grow_(ring* old, int64_t bottom, int64_t top) {
+        auto bigger = std::make_unique<ring>(old->capacity() * 2);
+        for (int64_t i = top; i < bottom; i++) {
+            bigger->put(i, old->get(i));
+        }
+        ring* r = bigger.get();
+        rings_.push_back(std::move(bigger));
+        ring_.store(r, std::memory_order_release);
+        return r;
+    }
+
+    alignas(cache_line_size) std::atomic<int64_t> top_{0};
+    alignas(cache_line_size) std::atomic<int64_t> bottom_{0};
+    alignas(cache_line_size) std::atomic<ring*> ring_{nullptr};
+    // every ring ever allocated, owner thread only
+    std::vector<std::unique_ptr<ring>> rings_;
+};
+
+} // namespace doca_stdexec
+
+#endif // DOCA_STDEXEC_COMMON_CHASE_LEV_DEQUE_HPP
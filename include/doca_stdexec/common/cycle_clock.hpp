@@ -0,0 +1,77 @@
+#pragma once
+#ifndef DOCA_STDEXEC_COMMON_CYCLE_CLOCK_HPP
+#define DOCA_STDEXEC_COMMON_CYCLE_CLOCK_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace doca_stdexec::cycle_clock {
+
+/**
+ * @brief Cycle counter of the calling CPU, constant-rate on the targets we run on
+ *
+ * A few nanoseconds to read, against a few tens for steady_clock, so it can
+ * be read several times per loop pass. Convert with ticks_per_ns().
+ */
+inline uint64_t now() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#elif defined(__aarch64__)
+    uint64_t value;
+    asm volatile("mrs %0, cntvct_el0" : "=r"(value));
+    return value;
+#else
+    return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+}
+
+namespace detail {
+
+struct anchor {
+    uint64_t ticks;
+    std::chrono::steady_clock::time_point time;
+};
+
+inline const anchor process_anchor{now(), std::chrono::steady_clock::now()};
+
+} // namespace detail
+
+/**
+ * @brief Rate of now(), calibrated against steady_clock since process start
+ *
+ * The estimate sharpens as the process runs; a call in the first 10ms
+ * sleeps until then. Not meant for the hot path.
+ */
+inline double ticks_per_ns() {
+#if defined(__aarch64__)
+    uint64_t frequency;
+    asm volatile("mrs %0, cntfrq_el0" : "=r"(frequency));
+    return static_cast<double>(frequency) / 1e9;
+#elif defined(__x86_64__) || defined(__i386__)
+    using namespace std::chrono_literals;
+    const auto& anchor = detail::process_anchor;
+    auto elapsed = std::chrono::steady_clock::now() - anchor.time;
+    if (elapsed < 10ms) {
+        std::this_thread::sleep_for(10ms - elapsed);
+    }
+    auto ticks = now() - anchor.ticks;
+    auto nanos = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - anchor.time).count();
+    return static_cast<double>(ticks) / nanos;
+#else
+    using period = std::chrono::steady_clock::period;
+    return static_cast<double>(period::den) / (static_cast<double>(period::num) * 1e9);
+#endif
+}
+
+inline uint64_t to_ns(uint64_t ticks, double ticks_per_ns) noexcept {
+    return static_cast<uint64_t>(static_cast<double>(ticks) / ticks_per_ns);
+}
+
+} // namespace doca_stdexec::cycle_clock
+
+#endif // DOCA_STDEXEC_COMMON_CYCLE_CLOCK_HPP
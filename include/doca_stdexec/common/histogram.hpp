@@ -0,0 +1,188 @@
+#pragma once
+#ifndef DOCA_STDEXEC_COMMON_HISTOGRAM_HPP
+#define DOCA_STDEXEC_COMMON_HISTOGRAM_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace doca_stdexec {
+
+class histogram_snapshot;
+
+/**
+ * @brief Lock-free log-linear histogram of non-negative integer values
+ *
+ * Same layout as an HdrHistogram: values below 128 get a bucket each, above
+ * that every power of two is split into 64 linear sub-buckets, so a bucket
+ * is never wider than 1/64 of its values (about 2 significant digits).
+ * Values from 2^32 up land in the last bucket; recorded in nanoseconds that
+ * is everything above 4.3 seconds, with `max` still exact.
+ *
+ * record() is a few relaxed atomic adds and may be called from any number
+ * of threads. snapshot() can run concurrently with recording: every bucket
+ * is read atomically, but records that race with it may be missing from it.
+ */
+class latency_histogram {
+public:
+    static constexpr unsigned sub_bucket_bits = 6;
+    static constexpr unsigned max_value_bits = 32;
+    static constexpr uint64_t sub_bucket_count = uint64_t{1} << sub_bucket_bits;
+    static constexpr size_t bucket_count = (max_value_bits - sub_bucket_bits + 1) * sub_bucket_count;
+
+    static constexpr size_t bucket_of(uint64_t value) noexcept {
+        if (value < 2 * sub_bucket_count) {
+            return static_cast<size_t>(value);
+        }
+        auto shift = static_cast<unsigned>(std::bit_width(value)) - sub_bucket_bits - 1;
+        if (shift > max_value_bits - sub_bucket_bits - 1) {
+            return bucket_count - 1;
+        }
+        return static_cast<size_t>(shift * sub_bucket_count + (value >> shift));
+    }
+
+    // smallest value recorded into `bucket`
+    static constexpr uint64_t lower_bound(size_t bucket) noexcept {
+        if (bucket < 2 * sub_bucket_count) {
+            return bucket;
+        }
+        auto shift = bucket / sub_bucket_count - 1;
+        return (bucket % sub_bucket_count + sub_bucket_count) << shift;
+    }
+
+    // largest value recorded into `bucket`, except for the last one
+    static constexpr uint64_t upper_bound(size_t bucket) noexcept {
+        return bucket + 1 < bucket_count ? lower_bound(bucket + 1) - 1 : UINT64_MAX;
+    }
+
+    latency_histogram() = default;
+
+    latency_histogram(const latency_histogram&) = delete;
+    latency_histogram& operator=(const latency_histogram&) = delete;
+
+    void record(uint64_t value) noexcept {
+        buckets_[bucket_of(value)].fetch_add(1, std::memory_order_relaxed);
+        sum_.fetch_add(value, std::memory_order_relaxed);
+        auto max = max_.load(std::memory_order_relaxed);
+        while (value > max && !max_.compare_exchange_weak(max, value, std::memory_order_relaxed)) {
+        }
+    }
+
+    histogram_snapshot snapshot() const;
+
+private:
+    std::array<std::atomic<uint64_t>, bucket_count> buckets_{};
+    std::atomic<uint64_t> sum_ = 0;
+    std::atomic<uint64_t> max_ = 0;
+};
+
+/**
+ * @brief Plain copy of a latency_histogram that can be merged and queried
+ *
+ * Snapshots of histograms recorded on different threads merge into one
+ * distribution; the difference to an earlier snapshot of the same histogram
+ * gives the distribution of a window without resetting anything.
+ */
+class histogram_snapshot {
+public:
+    histogram_snapshot() : counts_(latency_histogram::bucket_count, 0) {}
+
+    uint64_t count() const noexcept {
+        return count_;
+    }
+
+    uint64_t sum() const noexcept {
+        return sum_;
+    }
+
+    // exact, but over the histogram's whole lifetime even for a since() window
+    uint64_t max() const noexcept {
+        return max_;
+    }
+
+    double mean() const noexcept {
+        return count_ == 0 ? 0.0 : static_cast<double>(sum_) / static_cast<double>(count_);
+    }
+
+    /**
+     * @brief Smallest value that at least `quantile` of the records do not exceed
+     *
+     * Reported as the upper end of its bucket, so it overestimates by less
+     * than 1/64 and never underestimates.
+     *
+     * @param quantile In [0, 1], e.g. 0.999 for p99.9
+     * @return 0 for an empty snapshot
+     */
+    uint64_t percentile(double quantile) const noexcept {
+        if (count_ == 0) {
+            return 0;
+        }
+        auto rank = static_cast<uint64_t>(std::clamp(quantile, 0.0, 1.0) * static_cast<double>(count_));
+        rank = std::clamp<uint64_t>(rank, 1, count_);
+        uint64_t seen = 0;
+        for (size_t bucket = 0; bucket < counts_.size(); bucket++) {
+            seen += counts_[bucket];
+            if (seen >= rank) {
+                return std::min(latency_histogram::upper_bound(bucket), max_);
+            }
+        }
+        return max_;
+    }
+
+    std::span<const uint64_t> buckets() const noexcept {
+        return counts_;
+    }
+
+    histogram_snapshot& merge(const histogram_snapshot& other) noexcept {
+        for (size_t bucket = 0; bucket < counts_.size(); bucket++) {
+            counts_[bucket] += other.counts_[bucket];
+        }
+        count_ += other.count_;
+        sum_ += other.sum_;
+        max_ = std::max(max_, other.max_);
+        return *this;
+    }
+
+    /**
+     * @brief Records made after `earlier`, a previous snapshot of the same histogram
+     */
+    histogram_snapshot since(const histogram_snapshot& earlier) const {
+        histogram_snapshot window;
+        for (size_t bucket = 0; bucket < counts_.size(); bucket++) {
+            window.counts_[bucket] = counts_[bucket] - std::min(counts_[bucket], earlier.counts_[bucket]);
+            window.count_ += window.counts_[bucket];
+        }
+        window.sum_ = sum_ - std::min(sum_, earlier.sum_);
+        window.max_ = max_;
+        return window;
+    }
+
+private:
+    friend class latency_histogram;
+
+    std::vector<uint64_t> counts_;
+    uint64_t count_ = 0;
+    uint64_t sum_ = 0;
+    uint64_t max_ = 0;
+};
+
+inline histogram_snapshot latency_histogram::snapshot() const {
+    histogram_snapshot snapshot;
+    for (size_t bucket = 0; bucket < bucket_count; bucket++) {
+        auto count = buckets_[bucket].load(std::memory_order_relaxed);
+        snapshot.counts_[bucket] = count;
+        snapshot.count_ += count;
+    }
+    snapshot.sum_ = sum_.load(std::memory_order_relaxed);
+    snapshot.max_ = max_.load(std::memory_order_relaxed);
+    return snapshot;
+}
+
+} // namespace doca_stdexec
+
+#endif // DOCA_STDEXEC_COMMON_HISTOGRAM_HPP
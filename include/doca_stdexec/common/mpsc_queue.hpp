@@ -0,0 +1,140 @@
+#pragma once
+#ifndef DOCA_STDEXEC_COMMON_MPSC_QUEUE_HPP
+#define DOCA_STDEXEC_COMMON_MPSC_QUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+
+namespace doca_stdexec {
+
+// Fixed instead of std::hardware_destructive_interference_size, which is not
+// ABI-stable and warns under GCC.
+inline constexpr std::size_t cache_line_size = 64;
+
+template <typename Node>
+class intrusive_queue;
+
+/**
+ * @brief Intrusive lock-free multi-producer/single-consumer queue
+ *
+ * Producers push onto a Treiber stack with a single CAS and never wait for
+ * each other. The consumer takes everything pending with one exchange and
+ * reverses it into FIFO order, so a whole batch costs one atomic operation
+ * on the consumer side instead of one per node.
+ *
+ * @tparam Node Node type with a `std::atomic<Node*> next` member. Nodes must
+ *         stay alive until they are taken.
+ */
+template <typename Node>
+class mpsc_queue {
+public:
+    mpsc_queue() = default;
+
+    mpsc_queue(const mpsc_queue&) = delete;
+    mpsc_queue& operator=(const mpsc_queue&) = delete;
+
+    /**
+     * @brief Enqueue a node, callable from any thread
+     */
+    void push(Node* node) noexcept {
+        Node* head = head_.load(std::memory_order_relaxed);
+        do {
+            node->next.store(head, std::memory_order_relaxed);
+        } while (!head_.compare_exchange_weak(head, node, std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    /**
+     * @brief Move every pending node to the back of `into`, oldest first;
+     *        consumer thread only
+     * @return Number of nodes moved
+     */
+    size_t take_all(intrusive_queue<Node>& into) noexcept {
+        if (head_.load(std::memory_order_relaxed) == nullptr) {
+            return 0;
+        }
+        Node* node = head_.exchange(nullptr, std::memory_order_acquire);
+
+        Node* first = nullptr;
+        Node* last = node;
+        size_t count = 0;
+        while (node != nullptr) {
+            Node* next = node->next.load(std::memory_order_relaxed);
+            node->next.store(first, std::memory_order_relaxed);
+            first = node;
+            node = next;
+            count++;
+        }
+        if (first != nullptr) {
+            into.append(first, last);
+        }
+        return count;
+    }
+
+    /**
+     * @brief Cheap emptiness check that does not touch the consumer's state
+     */
+    bool empty() const noexcept {
+        return head_.load(std::memory_order_acquire) == nullptr;
+    }
+
+private:
+    alignas(cache_line_size) std::atomic<Node*> head_ = nullptr;
+};
+
+/**
+ * @brief Intrusive single-threaded FIFO queue
+ *
+ * Used for work posted by the thread that also consumes it, where no
+ * synchronization is needed at all, and as the consumer side of mpsc_queue.
+ */
+template <typename Node>
+class intrusive_queue {
+public:
+    intrusive_queue() = default;
+
+    intrusive_queue(const intrusive_queue&) = delete;
+    intrusive_queue& operator=(const intrusive_queue&) = delete;
+
+    void push(Node* node) noexcept {
+        node->next.store(nullptr, std::memory_order_relaxed);
+        if (tail_ == nullptr) {
+            head_ = node;
+        } else {
+            tail_->next.store(node, std::memory_order_relaxed);
+        }
+        tail_ = node;
+    }
+
+    // appends an already linked chain, `last->next` must be null
+    void append(Node* first, Node* last) noexcept {
+        if (tail_ == nullptr) {
+            head_ = first;
+        } else {
+            tail_->next.store(first, std::memory_order_relaxed);
+        }
+        tail_ = last;
+    }
+
+    Node* pop() noexcept {
+        Node* node = head_;
+        if (node != nullptr) {
+            head_ = node->next.load(std::memory_order_relaxed);
+            if (head_ == nullptr) {
+                tail_ = nullptr;
+            }
+        }
+        return node;
+    }
+
+    bool empty() const noexcept {
+        return head_ == nullptr;
+    }
+
+private:
+    Node* head_ = nullptr;
+    Node* tail_ = nullptr;
+};
+
+} // namespace doca_stdexec
+
+#endif // DOCA_STDEXEC_COMMON_MPSC_QUEUE_HPP
@@ -0,0 +1,99 @@
+#pragma once
+#ifndef DOCA_STDEXEC_COMMON_SPSC_RING_HPP
+#define DOCA_STDEXEC_COMMON_SPSC_RING_HPP
+
+#include "doca_stdexec/common/mpsc_queue.hpp"
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+
+namespace doca_stdexec {
+
+/**
+ * @brief Bounded lock-free single-producer/single-consumer ring
+ *
+ * Producer and consumer indices live on separate cache lines, and each side
+ * keeps a private copy of the other's index that it only refreshes when the
+ * ring looks full or empty, so in steady state neither side reads the
+ * other's line. The consumer takes a whole batch with one index update.
+ *
+ * @tparam T Trivially copyable element, usually a pointer
+ */
+template <typename T>
+class spsc_ring {
+    static_assert(std::is_trivially_copyable_v<T>);
+
+public:
+    // rounded up to a power of two
+    explicit spsc_ring(size_t capacity)
+        : mask_(std::bit_ceil(capacity < 2 ? size_t{2} : capacity) - 1),
+          slots_(std::make_unique<T[]>(mask_ + 1)) {}
+
+    spsc_ring(const spsc_ring&) = delete;
+    spsc_ring& operator=(const spsc_ring&) = delete;
+
+    size_t capacity() const noexcept {
+        return mask_ + 1;
+    }
+
+    /**
+     * @brief Producer only
+     * @return false if the ring is full
+     */
+    bool try_push(T value) noexcept {
+        auto tail = tail_.load(std::memory_order_relaxed);
+        if (tail - cached_head_ > mask_) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            if (tail - cached_head_ > mask_) {
+                return false;
+            }
+        }
+        slots_[tail & mask_] = value;
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Consumer only: hand every element present to `fn`, oldest first
+     * @return Number of elements consumed
+     */
+    template <typename Fn>
+    size_t consume_all(Fn&& fn) noexcept(noexcept(fn(std::declval<T>()))) {
+        auto head = head_.load(std::memory_order_relaxed);
+        if (head == cached_tail_) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            if (head == cached_tail_) {
+                return 0;
+            }
+        }
+        auto end = cached_tail_;
+        for (auto i = head; i != end; i++) {
+            fn(slots_[i & mask_]);
+        }
+        head_.store(end, std::memory_order_release);
+        return end - head;
+    }
+
+    // exact for either side, a hint for anyone else
+    bool empty() const noexcept {
+        return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+    }
+
+private:
+    const size_t mask_;
+    std::unique_ptr<T[]> slots_;
+
+    alignas(cache_line_size) std::atomic<size_t> tail_ = 0;
+    // producer's copy of head_
+    size_t cached_head_ = 0;
+
+    alignas(cache_line_size) std::atomic<size_t> head_ = 0;
+    // consumer's copy of tail_
+    size_t cached_tail_ = 0;
+};
+
+} // namespace doca_stdexec
+
+#endif // DOCA_STDEXEC_COMMON_SPSC_RING_HPP
@@ -0,0 +1,248 @@
+#pragma once
+#ifndef DOCA_STDEXEC_COMMON_TIMER_WHEEL_HPP
+#define DOCA_STDEXEC_COMMON_TIMER_WHEEL_HPP
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+namespace doca_stdexec {
+
+/**
+ * @brief Intrusive hook of a timer armed in a timer_wheel
+ */
+struct timer_node {
+    static constexpr uint32_t unlinked = UINT32_MAX;
+
+    timer_node* prev = nullptr;
+    timer_node* next = nullptr;
+    // expiry in wheel ticks
+    uint64_t deadline = 0;
+    uint32_t bucket = unlinked;
+    void (*fire)(timer_node*) noexcept = nullptr;
+
+    bool is_linked() const noexcept {
+        return bucket != unlinked;
+    }
+};
+
+/**
+ * @brief Hierarchical timer wheel with O(1) insert, remove and per-tick expiry
+ *
+ * Four levels of 64 slots at 1us resolution cover about 16.7 seconds;
+ * timers further out wait in an overflow list that is rescanned each time
+ * the top level wraps. Empty stretches are skipped using per-level occupancy masks,
+ * so advancing after a long sleep does not walk every tick.
+ *
+ * Single-threaded: only the owning PE thread may touch it.
+ */
+class timer_wheel {
+public:
+    using clock = std::chrono::steady_clock;
+    using tick = std::chrono::microseconds;
+
+    static constexpr unsigned slot_bits = 6;
+    static constexpr unsigned num_slots = 1U << slot_bits;
+    static constexpr unsigned num_levels = 4;
+
+    explicit timer_wheel(uint64_t now = to_ticks_floor(clock::now())) noexcept : now_(now) {}
+
+    timer_wheel(const timer_wheel&) = delete;
+    timer_wheel& operator=(const timer_wheel&) = delete;
+
+    static uint64_t to_ticks_floor(clock::time_point tp) noexcept {
+        return static_cast<uint64_t>(std::chrono::floor<tick>(tp.time_since_epoch()).count());
+    }
+
+    // deadlines round up so that timers never fire early
+    static uint64_t to_ticks_ceil(clock::time_point tp) noexcept {
+        return static_cast<uint64_t>(std::chrono::ceil<tick>(tp.time_since_epoch()).count());
+    }
+
+    static clock::time_point to_time_point(uint64_t ticks) noexcept {
+        return clock::time_point(std::chrono::duration_cast<clock::duration>(tick(ticks)));
+    }
+
+    /**
+     * @brief Arm a timer; node->deadline and node->fire must be set
+     *
+     * Deadlines that already passed fire on the next tick.
+     */
+    void insert(timer_node* node) noexcept {
+        node->deadline = std::max(node->deadline, now_ + 1);
+        place_(node);
+        size_++;
+    }
+
+    /**
+     * @brief Disarm a timer that has not fired yet
+     */
+    void remove(timer_node* node) noexcept {
+        if (!node->is_linked()) {
+            return;
+        }
+        unlink_(node);
+        size_--;
+    }
+
+    /**
+     * @brief Fire every timer whose deadline is at or before `target` ticks
+     * @return Number of timers fired
+     */
+    size_t advance(uint64_t target) noexcept {
+        size_t fired = 0;
+        while (now_ < target) {
+            now_ = std::min(next_stop_(target), target);
+
+            if ((now_ & (num_slots - 1)) == 0) {
+                cascade_();
+            }
+
+            auto slot = static_cast<uint32_t>(now_ & (num_slots - 1));
+            while (auto* node = heads_[slot]) {
+                unlink_(node);
+                size_--;
+                fired++;
+                node->fire(node);
+            }
+        }
+        return fired;
+    }
+
+    size_t advance(clock::time_point now) noexcept {
+        return advance(to_ticks_floor(now));
+    }
+
+    /**
+     * @brief Lower bound of the next expiry, nullopt if nothing is armed
+     *
+     * Waking up at this point may only cascade timers without firing any;
+     * ask again after advancing.
+     */
+    std::optional<clock::time_point> next_expiry() const noexcept {
+        if (size_ == 0) {
+            return std::nullopt;
+        }
+        return to_time_point(next_stop_(UINT64_MAX));
+    }
+
+    bool empty() const noexcept {
+        return size_ == 0;
+    }
+
+    size_t size() const noexcept {
+        return size_;
+    }
+
+private:
+    static constexpr uint32_t overflow_bucket = num_levels * num_slots;
+    static constexpr uint64_t range = 1ULL << (slot_bits * num_levels);
+
+    static uint64_t boundary_after(uint64_t now, unsigned level) noexcept {
+        auto mask = (1ULL << (slot_bits * (level + 1))) - 1;
+        return (now | mask) + 1;
+    }
+
+    // the next tick at which something may happen: a level-0 slot to expire
+    // or a boundary at which a higher level cascades down
+    uint64_t next_stop_(uint64_t target) const noexcept {
+        if (occupied_[0] != 0) {
+            auto index = static_cast<unsigned>(now_ & (num_slots - 1));
+            auto ahead = index == num_slots - 1 ? 0 : occupied_[0] & (~0ULL << (index + 1));
+            if (ahead != 0) {
+                return (now_ & ~uint64_t{num_slots - 1}) | static_cast<uint64_t>(std::countr_zero(ahead));
+            }
+            return boundary_after(now_, 0);
+        }
+        for (unsigned level = 1; level < num_levels; level++) {
+            if (occupied_[level] != 0) {
+                return boundary_after(now_, level - 1);
+            }
+        }
+        if (heads_[overflow_bucket] != nullptr) {
+            return boundary_after(now_, num_levels - 1);
+        }
+        return target;
+    }
+
+    void place_(timer_node* node) noexcept {
+        auto delta = node->deadline - now_;
+        uint32_t bucket = overflow_bucket;
+        if (delta < range) {
+            unsigned level = 0;
+            while (delta >= (1ULL << (slot_bits * (level + 1)))) {
+                level++;
+            }
+            auto slot = (node->deadline >> (slot_bits * level)) & (num_slots - 1);
+            bucket = static_cast<uint32_t>(level * num_slots + slot);
+            occupied_[level] |= 1ULL << slot;
+        }
+
+        node->bucket = bucket;
+        node->prev = nullptr;
+        node->next = heads_[bucket];
+        if (node->next != nullptr) {
+            node->next->prev = node;
+        }
+        heads_[bucket] = node;
+    }
+
+    void unlink_(timer_node* node) noexcept {
+        auto bucket = node->bucket;
+        if (node->prev != nullptr) {
+            node->prev->next = node->next;
+        } else {
+            heads_[bucket] = node->next;
+        }
+        if (node->next != nullptr) {
+            node->next->prev = node->prev;
+        }
+        if (heads_[bucket] == nullptr && bucket != overflow_bucket) {
+            occupied_[bucket / num_slots] &= ~(1ULL << (bucket % num_slots));
+        }
+        node->prev = node->next = nullptr;
+        node->bucket = timer_node::unlinked;
+    }
+
+    void redistribute_(uint32_t bucket) noexcept {
+        auto* node = heads_[bucket];
+        heads_[bucket] = nullptr;
+        if (bucket != overflow_bucket) {
+            occupied_[bucket / num_slots] &= ~(1ULL << (bucket % num_slots));
+        }
+        while (node != nullptr) {
+            auto* next = node->next;
+            place_(node);
+            node = next;
+        }
+    }
+
+    // called on every level-0 boundary, moves the slots that just came into
+    // range one level down, highest level first
+    void cascade_() noexcept {
+        unsigned top = 1;
+        while (top < num_levels && (now_ & ((1ULL << (slot_bits * (top + 1))) - 1)) == 0) {
+            top++;
+        }
+        if (top == num_levels && heads_[overflow_bucket] != nullptr) {
+            // the highest level wrapped, pull in overflow timers that are now in range
+            redistribute_(overflow_bucket);
+        }
+        for (unsigned level = std::min(top, num_levels - 1); level >= 1; level--) {
+            auto slot = (now_ >> (slot_bits * level)) & (num_slots - 1);
+            redistribute_(static_cast<uint32_t>(level * num_slots + slot));
+        }
+    }
+
+    uint64_t now_;
+    size_t size_ = 0;
+    uint64_t occupied_[num_levels] = {};
+    timer_node* heads_[num_levels * num_slots + 1] = {};
+};
+
+} // namespace doca_stdexec
+
+#endif // DOCA_STDEXEC_COMMON_TIMER_WHEEL_HPP
@@ -8,6 +8,10 @@
 
 namespace doca_stdexec {
 
+namespace loop {
+class doca_pe_run_loop;
+} // namespace loop
+
 struct Context {
 
   void set_state_changed_cb(doca_ctx_state_changed_callback_t cb) {
@@ -20,13 +24,19 @@ struct Context {
     check_error(status, "Failed to start context");
   }
 
-  void stop() {
+  // contexts that hold DOCA objects of their own release them here first
+  virtual void stop() {
     doca_error_t status = doca_ctx_stop(as_ctx());
     check_error(status, "Failed to stop context");
   }
 
   virtual ~Context() = default;
   virtual doca_ctx *as_ctx() noexcept = 0;
+
+  // run loop of the PE this context is connected to, set by its
+  // connect_ctx, the only way to connect one; operations on the context
+  // complete on its thread
+  loop::doca_pe_run_loop *connected_loop = nullptr;
 };
 
 } // namespace doca_stdexec
@@ -0,0 +1,398 @@
+#pragma once
+#ifndef DOCA_STDEXEC_CORO_HPP
+#define DOCA_STDEXEC_CORO_HPP
+
+#include "doca_stdexec/common.hpp"
+#include "doca_stdexec/frame_pool.hpp"
+#include "doca_stdexec/operation.hpp"
+#include <coroutine>
+#include <cstddef>
+#include <doca_error.h>
+#include <exception>
+#include <optional>
+#include <stdexec/execution.hpp>
+#include <type_traits>
+#include <utility>
+
+namespace doca_stdexec::coro {
+
+template <typename T = void>
+class task;
+
+namespace detail {
+
+struct promise_base {
+    // Frames come from the frame pool of the PE thread the coroutine is
+    // called on, so coroutines started from PE tasks and completions recycle
+    // their frames.
+    static void* operator new(size_t size) {
+        return frame_pool::allocate(size);
+    }
+
+    static void operator delete(void* p) noexcept {
+        frame_pool::deallocate(p);
+    }
+
+    // the awaiting coroutine, null for the task a sender operation runs
+    std::coroutine_handle<> continuation_;
+    promise_base* parent_ = nullptr;
+
+    // set on the outermost task by the operation running it
+    void* root_ = nullptr;
+    void (*root_complete_)(void*) noexcept = nullptr;
+    void (*root_stopped_)(void*) noexcept = nullptr;
+
+    stdexec::inplace_stop_token stop_token_;
+    std::exception_ptr exception_;
+
+    std::suspend_always initial_suspend() noexcept {
+        return {};
+    }
+
+    struct final_awaiter {
+        bool await_ready() noexcept {
+            return false;
+        }
+
+        template <typename Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> h) noexcept {
+            auto& promise = h.promise();
+            if (promise.continuation_) {
+                return promise.continuation_;
+            }
+            // may destroy this frame, which is suspended by now
+            promise.root_complete_(promise.root_);
+            return std::noop_coroutine();
+        }
+
+        void await_resume() noexcept {}
+    };
+
+    final_awaiter final_suspend() noexcept {
+        return {};
+    }
+
+    void unhandled_exception() noexcept {
+        exception_ = std::current_exception();
+    }
+
+    // An awaited sender completed with set_stopped: the whole chain of
+    // tasks up to the operation stops, without resuming any of them.
+    void unhandled_stopped() noexcept {
+        auto* root = this;
+        while (root->parent_ != nullptr) {
+            root = root->parent_;
+        }
+        root->root_stopped_(root->root_);
+    }
+
+    template <typename Sender>
+    auto await_transform(Sender&& sndr);
+
+    template <typename U>
+    task<U>&& await_transform(task<U>&& t) noexcept {
+        return static_cast<task<U>&&>(t);
+    }
+};
+
+template <typename T>
+struct promise : promise_base {
+    std::optional<T> value_;
+
+    task<T> get_return_object() noexcept;
+
+    template <typename U = T>
+    void return_value(U&& value) {
+        value_.emplace(static_cast<U&&>(value));
+    }
+
+    T result() {
+        if (exception_) {
+            std::rethrow_exception(exception_);
+        }
+        return std::move(*value_);
+    }
+};
+
+template <>
+struct promise<void> : promise_base {
+    task<void> get_return_object() noexcept;
+
+    void return_void() noexcept {}
+
+    void result() {
+        if (exception_) {
+            std::rethrow_exception(exception_);
+        }
+    }
+};
+
+/**
+ * @brief Awaits a sender completing with set_value() from inside a task
+ *
+ * The operation state lives in the awaiter, i.e. in the coroutine frame,
+ * and the receiver resumes the coroutine right inside the completion: for
+ * an RDMA sender that is the DOCA completion callback on the PE thread, so
+ * the coroutine continues there without a trip through the run loop.
+ */
+template <typename Sender>
+class sender_awaiter {
+    struct env {
+        const promise_base* promise_;
+
+        auto query(stdexec::get_stop_token_t) const noexcept -> stdexec::inplace_stop_token {
+            return promise_->stop_token_;
+        }
+    };
+
+    struct receiver {
+        using receiver_concept = stdexec::receiver_t;
+
+        sender_awaiter* self_;
+
+        void set_value() noexcept {
+            self_->continuation_.resume();
+        }
+
+        template <typename Error>
+        void set_error(Error&& err) noexcept {
+            if constexpr (std::same_as<std::decay_t<Error>, std::exception_ptr>) {
+                self_->error_ = static_cast<Error&&>(err);
+            } else if constexpr (std::same_as<std::decay_t<Error>, doca_error_t>) {
+                self_->error_ = std::make_exception_ptr(doca_failure(err));
+            } else {
+                self_->error_ = std::make_exception_ptr(static_cast<Error&&>(err));
+            }
+            self_->continuation_.resume();
+        }
+
+        void set_stopped() noexcept {
+            self_->promise_->unhandled_stopped();
+        }
+
+        [[nodiscard]]
+        auto get_env() const noexcept -> env {
+            return env{self_->promise_};
+        }
+    };
+
+public:
+    sender_awaiter(Sender&& sndr, promise_base& promise)
+        : promise_(&promise), op_(stdexec::connect(static_cast<Sender&&>(sndr), receiver{this})) {}
+
+    sender_awaiter(const sender_awaiter&) = delete;
+    sender_awaiter& operator=(const sender_awaiter&) = delete;
+
+    bool await_ready() const noexcept {
+        return false;
+    }
+
+    void await_suspend(std::coroutine_handle<> continuation) noexcept {
+        continuation_ = continuation;
+        stdexec::start(op_);
+    }
+
+    void await_resume() {
+        if (error_) {
+            std::rethrow_exception(std::move(error_));
+        }
+    }
+
+private:
+    promise_base* promise_;
+    std::coroutine_handle<> continuation_;
+    std::exception_ptr error_;
+    stdexec::connect_result_t<Sender, receiver> op_;
+};
+
+template <typename Sender>
+auto promise_base::await_transform(Sender&& sndr) {
+    return sender_awaiter<Sender>{static_cast<Sender&&>(sndr), *this};
+}
+
+template <typename T>
+struct value_signature {
+    using type = stdexec::set_value_t(T);
+};
+
+template <>
+struct value_signature<void> {
+    using type = stdexec::set_value_t();
+};
+
+} // namespace detail
+
+/**
+ * @brief Lazily started coroutine returning T
+ *
+ * Inside a task, RDMA senders and other senders completing with set_value()
+ * can be awaited directly, and so can other tasks:
+ *
+ *   coro::task<> echo(RdmaConnection& connection, Buf src, Buf dst) {
+ *       co_await connection.write(src, dst);
+ *       co_await connection.read(dst, src);
+ *   }
+ *
+ * A task is itself a sender, so the outermost one is started with
+ * sync_wait, start_detached or let_value. A sender completing with a DOCA
+ * error throws doca_failure at the `co_await`; one completing with
+ * set_stopped stops the whole chain of tasks, and the outermost one
+ * completes with set_stopped. The stop token of the outermost receiver is
+ * passed on to every awaited sender.
+ *
+ * Frames are allocated from the frame pool of the PE thread that calls the
+ * coroutine function, so create tasks on the PE thread, e.g. inside
+ * let_value after schedule(), to have them recycled.
+ */
+template <typename T>
+class task {
+public:
+    using promise_type = detail::promise<T>;
+    using handle_type = std::coroutine_handle<promise_type>;
+
+    using sender_concept = stdexec::sender_t;
+    using completion_signatures =
+        stdexec::completion_signatures<typename detail::value_signature<T>::type,
+                                       stdexec::set_error_t(std::exception_ptr), stdexec::set_stopped_t()>;
+
+    explicit task(handle_type handle) noexcept : handle_(handle) {}
+
+    task(task&& other) noexcept : handle_(std::exchange(other.handle_, {})) {}
+
+    task& operator=(task&& other) noexcept {
+        if (this != &other) {
+            if (handle_) {
+                handle_.destroy();
+            }
+            handle_ = std::exchange(other.handle_, {});
+        }
+        return *this;
+    }
+
+    ~task() {
+        if (handle_) {
+            handle_.destroy();
+        }
+    }
+
+    // awaited from another task: runs as a nested call through symmetric transfer
+    bool await_ready() const noexcept {
+        return false;
+    }
+
+    template <typename Promise>
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> continuation) noexcept {
+        auto& promise = handle_.promise();
+        promise.continuation_ = continuation;
+        promise.parent_ = &continuation.promise();
+        promise.stop_token_ = continuation.promise().stop_token_;
+        return handle_;
+    }
+
+    T await_resume() {
+        return handle_.promise().result();
+    }
+
+    template <typename Receiver>
+    class operation : immovable {
+        using stop_token_t = stdexec::stop_token_of_t<stdexec::env_of_t<Receiver>>;
+
+        struct forward_stop {
+            stdexec::inplace_stop_source* source_;
+
+            void operator()() const noexcept {
+                source_->request_stop();
+            }
+        };
+
+        // receivers with their own inplace_stop_token pass it on as is
+        static constexpr bool forwards_stop =
+            !std::same_as<stop_token_t, stdexec::inplace_stop_token> && !stdexec::unstoppable_token<stop_token_t>;
+
+        struct no_forwarding {};
+        using stop_state = std::conditional_t<forwards_stop, stdexec::inplace_stop_source, no_forwarding>;
+        using stop_callback =
+            std::conditional_t<forwards_stop, std::optional<stdexec::stop_callback_for_t<stop_token_t, forward_stop>>,
+                               no_forwarding>;
+
+    public:
+        operation(handle_type handle, Receiver rcvr) noexcept
+            : handle_(handle), rcvr_(static_cast<Receiver&&>(rcvr)) {}
+
+        ~operation() {
+            if (handle_) {
+                handle_.destroy();
+            }
+        }
+
+        void start() & noexcept {
+            auto& promise = handle_.promise();
+            promise.root_ = this;
+            promise.root_complete_ = &complete_;
+            promise.root_stopped_ = &stopped_;
+
+            auto token = stdexec::get_stop_token(stdexec::get_env(rcvr_));
+            if constexpr (std::same_as<stop_token_t, stdexec::inplace_stop_token>) {
+                promise.stop_token_ = token;
+            } else if constexpr (forwards_stop) {
+                on_stop_.emplace(token, forward_stop{&stop_source_});
+                promise.stop_token_ = stop_source_.get_token();
+            }
+            handle_.resume();
+        }
+
+    private:
+        static void complete_(void* p) noexcept {
+            auto* self = static_cast<operation*>(p);
+            auto& promise = self->handle_.promise();
+            if constexpr (forwards_stop) {
+                self->on_stop_.reset();
+            }
+            if (promise.exception_) {
+                stdexec::set_error(static_cast<Receiver&&>(self->rcvr_), std::move(promise.exception_));
+            } else if constexpr (std::is_void_v<T>) {
+                stdexec::set_value(static_cast<Receiver&&>(self->rcvr_));
+            } else {
+                stdexec::set_value(static_cast<Receiver&&>(self->rcvr_), std::move(*promise.value_));
+            }
+        }
+
+        static void stopped_(void* p) noexcept {
+            auto* self = static_cast<operation*>(p);
+            if constexpr (forwards_stop) {
+                self->on_stop_.reset();
+            }
+            stdexec::set_stopped(static_cast<Receiver&&>(self->rcvr_));
+        }
+
+        handle_type handle_;
+        [[no_unique_address]] Receiver rcvr_;
+        [[no_unique_address]] stop_state stop_source_;
+        [[no_unique_address]] stop_callback on_stop_;
+    };
+
+    template <stdexec::receiver Receiver>
+    auto connect(Receiver rcvr) && noexcept -> operation<Receiver> {
+        return {std::exchange(handle_, {}), static_cast<Receiver&&>(rcvr)};
+    }
+
+private:
+    handle_type handle_;
+};
+
+namespace detail {
+
+template <typename T>
+task<T> promise<T>::get_return_object() noexcept {
+    return task<T>{std::coroutine_handle<promise>::from_promise(*this)};
+}
+
+inline task<void> promise<void>::get_return_object() noexcept {
+    return task<void>{std::coroutine_handle<promise>::from_promise(*this)};
+}
+
+} // namespace detail
+
+} // namespace doca_stdexec::coro
+
+#endif // DOCA_STDEXEC_CORO_HPP
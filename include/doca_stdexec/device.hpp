@@ -6,8 +6,11 @@
 
 #include <doca_dev.h>
 #include <doca_types.h>
+#include <string>
+#include <vector>
 
 #include "common.hpp"
+#include "topology.hpp"
 
 namespace doca_stdexec {
 
@@ -69,6 +72,26 @@ struct Device : public std::enable_shared_from_this<Device> {
   ~Device() = default;
 
   doca_dev *get() const noexcept { return device.get(); }
+
+  std::string pci_addr() const {
+    char pci_addr_str[DOCA_DEVINFO_PCI_ADDR_SIZE];
+    auto status =
+        doca_devinfo_get_pci_addr_str(doca_dev_as_devinfo(get()), pci_addr_str);
+    check_error(status, "Failed to get device pci address");
+    return pci_addr_str;
+  }
+
+  /**
+   * @brief NUMA node the NIC is attached to, -1 if unknown
+   */
+  int numa_node() const { return topology::pci_numa_node(pci_addr()); }
+
+  /**
+   * @brief CPUs on the NIC's socket
+   */
+  std::vector<int> local_cpus() const {
+    return topology::pci_local_cpus(pci_addr());
+  }
 };
 
 } // namespace doca_stdexec
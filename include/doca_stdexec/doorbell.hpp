@@ -0,0 +1,207 @@
+#pragma once
+#ifndef DOCA_STDEXEC_DOORBELL_HPP
+#define DOCA_STDEXEC_DOORBELL_HPP
+
+#include "doca_stdexec/common.hpp"
+#include "doca_stdexec/operation.hpp"
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <doca_pe.h>
+#include <stdexec/execution.hpp>
+#include <utility>
+
+namespace doca_stdexec {
+
+struct doorbell_stats {
+    // tasks handed to DOCA, and doorbells rung for them
+    uint64_t submitted = 0;
+    uint64_t flushes = 0;
+};
+
+/**
+ * @brief Submits the DOCA tasks of one context, deferring the doorbell
+ *        while a batch is open
+ *
+ * Outside a batch every task is submitted and flushed on its own. Inside
+ * one the latest task is held back and the one before it is submitted with
+ * DOCA_TASK_SUBMIT_FLAG_NONE; closing the batch flushes the held task,
+ * ringing the doorbell once for all of them. A task for another queue
+ * flushes the held one instead, the flush only covers its own queue.
+ *
+ * Batches nest, and belong to the PE thread like the tasks:
+ *
+ *   {
+ *       doorbell::batch scope{rdma->bell};
+ *       for (auto& op : ops) stdexec::start(op);
+ *   } // one doorbell
+ */
+class doorbell {
+public:
+    class batch {
+    public:
+        explicit batch(doorbell& bell) noexcept : bell_(&bell) {
+            bell_->open();
+        }
+
+        batch(const batch&) = delete;
+        batch& operator=(const batch&) = delete;
+
+        ~batch() {
+            bell_->close();
+        }
+
+    private:
+        doorbell* bell_;
+    };
+
+    // `queue` identifies the queue the task goes to, e.g. its connection
+    void submit(doca_task* task, const void* queue) noexcept {
+        stats_.submitted++;
+        if (depth_ == 0) {
+            stats_.flushes++;
+            check_error(doca_task_submit(task), "Failed to submit task");
+            return;
+        }
+        if (held_ != nullptr) {
+            submit_held_(held_queue_ == queue ? DOCA_TASK_SUBMIT_FLAG_NONE : DOCA_TASK_SUBMIT_FLAG_FLUSH);
+        }
+        held_ = task;
+        held_queue_ = queue;
+    }
+
+    void open() noexcept {
+        depth_++;
+    }
+
+    void close() noexcept {
+        if (--depth_ == 0 && held_ != nullptr) {
+            submit_held_(DOCA_TASK_SUBMIT_FLAG_FLUSH);
+        }
+    }
+
+    [[nodiscard]]
+    doorbell_stats stats() const noexcept {
+        return stats_;
+    }
+
+private:
+    void submit_held_(uint32_t flags) noexcept {
+        auto* task = std::exchange(held_, nullptr);
+        if (flags & DOCA_TASK_SUBMIT_FLAG_FLUSH) {
+            stats_.flushes++;
+        }
+        check_error(doca_task_submit_ex(task, flags), "Failed to submit task");
+    }
+
+    unsigned depth_ = 0;
+    doca_task* held_ = nullptr;
+    const void* held_queue_ = nullptr;
+    doorbell_stats stats_;
+};
+
+// a sender whose operation submits its task through a doorbell
+template <class Sender>
+concept doorbell_sender = requires(const Sender& sndr) {
+    { sndr.get_doorbell() } -> std::same_as<doorbell*>;
+};
+
+namespace detail {
+
+// Forwards to Child without being a doorbell_sender, so that the when_all
+// built around the children of a batch is not batched again.
+template <class Child>
+struct unbatched {
+    using sender_concept = stdexec::sender_t;
+
+    template <class... Env>
+    friend auto get_completion_signatures(const unbatched&, Env&&...)
+        -> stdexec::completion_signatures_of_t<Child, Env...> {
+        return {};
+    }
+
+    template <class Receiver>
+    auto connect(Receiver rcvr) && {
+        return stdexec::connect(static_cast<Child&&>(child), static_cast<Receiver&&>(rcvr));
+    }
+
+    [[nodiscard]]
+    auto get_env() const noexcept {
+        return stdexec::get_env(child);
+    }
+
+    Child child;
+};
+
+/**
+ * @brief Starts Sender with a batch open on each of the doorbells
+ */
+template <class Sender, size_t N>
+struct batched {
+    using sender_concept = stdexec::sender_t;
+
+    template <class Receiver>
+    struct operation : immovable {
+        operation(Sender&& sndr, const std::array<doorbell*, N>& doorbells, Receiver&& rcvr)
+            : doorbells_(doorbells),
+              op_(stdexec::connect(static_cast<Sender&&>(sndr), static_cast<Receiver&&>(rcvr))) {}
+
+        void start() & noexcept {
+            // the operation may complete, and be destroyed, within start
+            auto doorbells = doorbells_;
+            for (auto* bell : doorbells) {
+                bell->open();
+            }
+            stdexec::start(op_);
+            for (auto* bell : doorbells) {
+                bell->close();
+            }
+        }
+
+    private:
+        std::array<doorbell*, N> doorbells_;
+        stdexec::connect_result_t<Sender, Receiver> op_;
+    };
+
+    template <class... Env>
+    friend auto get_completion_signatures(const batched&, Env&&...)
+        -> stdexec::completion_signatures_of_t<Sender, Env...> {
+        return {};
+    }
+
+    template <class Receiver>
+    auto connect(Receiver rcvr) && -> operation<Receiver> {
+        return {static_cast<Sender&&>(sndr), doorbells, static_cast<Receiver&&>(rcvr)};
+    }
+
+    [[nodiscard]]
+    auto get_env() const noexcept {
+        return stdexec::get_env(sndr);
+    }
+
+    std::array<doorbell*, N> doorbells;
+    Sender sndr;
+};
+
+} // namespace detail
+
+/**
+ * @brief when_all of the senders, submitting their tasks with one doorbell
+ *        per queue
+ *
+ * Must be started on the PE thread of the senders' contexts. when_all of
+ * RDMA senders alone is turned into this by the run loop's domain.
+ */
+template <doorbell_sender... Senders>
+auto batch(Senders&&... senders) {
+    using all_sender = decltype(stdexec::when_all(std::declval<detail::unbatched<std::decay_t<Senders>>>()...));
+    // braced initialization reads every doorbell before the senders move
+    return detail::batched<all_sender, sizeof...(Senders)>{
+        {senders.get_doorbell()...},
+        stdexec::when_all(detail::unbatched<std::decay_t<Senders>>{static_cast<Senders&&>(senders)}...)};
+}
+
+} // namespace doca_stdexec
+
+#endif // DOCA_STDEXEC_DOORBELL_HPP
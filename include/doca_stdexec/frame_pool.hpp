@@ -0,0 +1,156 @@
+#pragma once
+#ifndef DOCA_STDEXEC_FRAME_POOL_HPP
+#define DOCA_STDEXEC_FRAME_POOL_HPP
+
+#include "doca_stdexec/common/mpsc_queue.hpp"
+#include "doca_stdexec/loop_counters.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+namespace doca_stdexec {
+
+/**
+ * @brief Recycling allocator for coroutine frames and detached operation
+ *        states, one per run loop
+ *
+ * Blocks are rounded up to power-of-two size classes and kept on per-class
+ * free lists once freed, so a coroutine or a spawned operation that is
+ * created and destroyed over and over reuses the same few blocks and a
+ * steady-state request loop allocates nothing. pool_allocator
+ * (allocator.hpp) exposes it to senders. Only the owning PE thread allocates from and frees
+ * into the local lists without synchronization; a frame destroyed on any
+ * other thread goes onto a lock-free list the owner takes over when its own
+ * list of that class runs dry.
+ *
+ * Allocations on threads without a pool, and frames above the largest
+ * class, go to the heap. Pooled frames must not outlive their pool.
+ */
+class frame_pool {
+public:
+    static constexpr size_t min_block_size = 64;
+    static constexpr size_t class_count = 8;
+    static constexpr size_t max_block_size = min_block_size << (class_count - 1);
+
+    // pool of the run loop running on this thread, if any
+    static inline thread_local frame_pool* current = nullptr;
+
+    frame_pool() = default;
+    frame_pool(const frame_pool&) = delete;
+    frame_pool& operator=(const frame_pool&) = delete;
+
+    ~frame_pool() {
+        for (size_t cls = 0; cls < class_count; cls++) {
+            release_(local_[cls]);
+            release_(remote_[cls].exchange(nullptr, std::memory_order_acquire));
+        }
+    }
+
+    /**
+     * @brief Block of at least `size` bytes from the calling thread's pool
+     */
+    static void* allocate(size_t size) {
+        auto block_size = std::bit_ceil(size + sizeof(header));
+        auto* pool = current;
+        if (pool == nullptr || block_size > max_block_size) {
+            auto* h = static_cast<header*>(::operator new(size + sizeof(header)));
+            h->owner = nullptr;
+            return h + 1;
+        }
+        return pool->allocate_(class_of_(block_size));
+    }
+
+    static void deallocate(void* p) noexcept {
+        auto* h = static_cast<header*>(p) - 1;
+        if (h->owner == nullptr) {
+            ::operator delete(h);
+        } else {
+            h->owner->deallocate_(h);
+        }
+    }
+
+    // blocks taken from the heap, only growing while the pool warms up
+    [[nodiscard]]
+    uint64_t heap_allocations() const noexcept {
+        return heap_allocations_.load();
+    }
+
+    // blocks served from a free list
+    [[nodiscard]]
+    uint64_t recycled() const noexcept {
+        return recycled_.load();
+    }
+
+private:
+    // keeps the frame at the default new alignment
+    struct alignas(__STDCPP_DEFAULT_NEW_ALIGNMENT__) header {
+        frame_pool* owner;
+        size_t cls;
+    };
+
+    struct free_block {
+        free_block* next;
+    };
+
+    static size_t class_of_(size_t block_size) noexcept {
+        return std::countr_zero(std::max(block_size, min_block_size)) - std::countr_zero(min_block_size);
+    }
+
+    void* allocate_(size_t cls) {
+        auto* block = local_[cls];
+        if (block == nullptr) {
+            block = remote_[cls].exchange(nullptr, std::memory_order_acquire);
+        }
+
+        header* h;
+        if (block != nullptr) {
+            local_[cls] = block->next;
+            recycled_.add(1);
+            h = reinterpret_cast<header*>(block);
+        } else {
+            h = static_cast<header*>(::operator new(min_block_size << cls));
+            heap_allocations_.add(1);
+        }
+        h->owner = this;
+        h->cls = cls;
+        return h + 1;
+    }
+
+    void deallocate_(header* h) noexcept {
+        auto cls = h->cls;
+        auto* block = reinterpret_cast<free_block*>(h);
+        if (current == this) {
+            block->next = local_[cls];
+            local_[cls] = block;
+            return;
+        }
+        auto& remote = remote_[cls];
+        block->next = remote.load(std::memory_order_relaxed);
+        while (!remote.compare_exchange_weak(block->next, block, std::memory_order_release,
+                                             std::memory_order_relaxed)) {
+        }
+    }
+
+    static void release_(free_block* block) noexcept {
+        while (block != nullptr) {
+            ::operator delete(std::exchange(block, block->next));
+        }
+    }
+
+    // PE thread only
+    std::array<free_block*, class_count> local_{};
+    loop::counter heap_allocations_;
+    loop::counter recycled_;
+
+    // pushed by other threads, taken whole by the owner
+    alignas(cache_line_size) std::array<std::atomic<free_block*>, class_count> remote_{};
+};
+
+} // namespace doca_stdexec
+
+#endif // DOCA_STDEXEC_FRAME_POOL_HPP
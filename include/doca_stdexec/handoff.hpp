@@ -0,0 +1,280 @@
+#pragma once
+#ifndef DOCA_STDEXEC_HANDOFF_HPP
+#define DOCA_STDEXEC_HANDOFF_HPP
+
+#include "doca_stdexec/common/spsc_ring.hpp"
+#include "doca_stdexec/loop_counters.hpp"
+#include "doca_stdexec/progress_engine.hpp"
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <optional>
+#include <stdexec/execution.hpp>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace doca_stdexec {
+
+struct handoff_stats {
+    // continuations passed to the destination through the ring
+    uint64_t handed_off = 0;
+    // continuations scheduled on the destination one by one, because the
+    // ring was full or they did not start on the PE thread
+    uint64_t bypassed = 0;
+    // drains scheduled on the destination, each one wakeup of a worker
+    uint64_t wakeups = 0;
+
+    [[nodiscard]]
+    double per_wakeup() const noexcept {
+        return wakeups > 0 ? static_cast<double>(handed_off) / static_cast<double>(wakeups) : 0.0;
+    }
+};
+
+/**
+ * @brief Moves continuations from a PE thread to another scheduler in batches
+ *
+ * `continues_on(pool)` after an RDMA sender schedules every completion on
+ * the pool separately, and a pool typically wakes a worker for each one.
+ * The channel's scheduler instead queues each continuation started on the
+ * PE thread into a single-producer/single-consumer ring, and at the end of
+ * the loop pass schedules one drain on the destination, unless one is still
+ * running, which then picks the new continuations up as well. A burst of
+ * completions thus costs one wakeup.
+ *
+ *   handoff_channel channel{context, pool.get_scheduler()};
+ *   connection.write(src, dst) | stdexec::continues_on(channel.get_scheduler()) | ...
+ *
+ * Continuations that start on any other thread, or find the ring full, are
+ * scheduled on the destination directly, so they may overtake queued ones.
+ *
+ * The PE thread is the only producer, so a channel serves one run loop. It
+ * must outlive every operation started on its scheduler.
+ */
+template <typename Scheduler>
+class handoff_channel {
+    struct item {
+        void (*deliver)(item*, bool stopped) noexcept = nullptr;
+    };
+
+    template <typename Receiver>
+    struct operation : item {
+        // the direct path through the destination's own schedule()
+        struct bypass_receiver {
+            using receiver_concept = stdexec::receiver_t;
+
+            operation* op_;
+
+            void set_value() noexcept {
+                stdexec::set_value(static_cast<Receiver&&>(op_->rcvr_));
+            }
+
+            template <typename Error>
+            void set_error(Error&& err) noexcept {
+                if constexpr (std::same_as<std::decay_t<Error>, std::exception_ptr>) {
+                    stdexec::set_error(static_cast<Receiver&&>(op_->rcvr_), static_cast<Error&&>(err));
+                } else {
+                    stdexec::set_error(static_cast<Receiver&&>(op_->rcvr_),
+                                       std::make_exception_ptr(static_cast<Error&&>(err)));
+                }
+            }
+
+            void set_stopped() noexcept {
+                stdexec::set_stopped(static_cast<Receiver&&>(op_->rcvr_));
+            }
+
+            auto get_env() const noexcept -> stdexec::env_of_t<Receiver> {
+                return stdexec::get_env(op_->rcvr_);
+            }
+        };
+
+        using bypass_op = stdexec::connect_result_t<stdexec::schedule_result_t<Scheduler&>, bypass_receiver>;
+
+        handoff_channel* channel_;
+        [[no_unique_address]] Receiver rcvr_;
+        std::optional<bypass_op> bypass_;
+
+        operation(handoff_channel* channel, Receiver rcvr)
+            : item{&deliver_impl}, channel_(channel), rcvr_(static_cast<Receiver&&>(rcvr)) {}
+
+        operation(const operation&) = delete;
+        operation& operator=(const operation&) = delete;
+
+        // on a destination thread, from the drain
+        static void deliver_impl(item* p, bool stopped) noexcept {
+            auto& rcvr = static_cast<operation*>(p)->rcvr_;
+            if (stopped) {
+                stdexec::set_stopped(static_cast<Receiver&&>(rcvr));
+            } else {
+                loop::detail::complete_schedule(rcvr);
+            }
+        }
+
+        void start() & noexcept {
+            if (channel_->try_enqueue_(this)) {
+                return;
+            }
+
+            channel_->bypassed_.fetch_add(1, std::memory_order_relaxed);
+            try {
+                auto connect = [this] {
+                    return stdexec::connect(stdexec::schedule(channel_->destination_), bypass_receiver{this});
+                };
+                stdexec::start(bypass_.emplace(emplace_from<bypass_op, decltype(connect)>{connect}));
+            } catch (...) {
+                stdexec::set_error(static_cast<Receiver&&>(rcvr_), std::current_exception());
+            }
+        }
+    };
+
+public:
+    class scheduler {
+        struct schedule_task {
+            using sender_concept = stdexec::sender_t;
+            using completion_signatures =
+                stdexec::completion_signatures<stdexec::set_value_t(), stdexec::set_error_t(std::exception_ptr),
+                                               stdexec::set_stopped_t()>;
+
+            struct env {
+                handoff_channel* channel_;
+
+                template <class CPO>
+                auto query(stdexec::get_completion_scheduler_t<CPO>) const noexcept -> scheduler {
+                    return scheduler{channel_};
+                }
+            };
+
+            handoff_channel* channel_;
+
+            template <stdexec::receiver Receiver>
+            auto connect(Receiver rcvr) const -> operation<Receiver> {
+                return {channel_, static_cast<Receiver&&>(rcvr)};
+            }
+
+            [[nodiscard]]
+            auto get_env() const noexcept -> env {
+                return env{channel_};
+            }
+        };
+
+        friend handoff_channel;
+
+        explicit scheduler(handoff_channel* channel) noexcept : channel_(channel) {}
+
+        handoff_channel* channel_;
+
+    public:
+        auto operator==(const scheduler&) const noexcept -> bool = default;
+
+        [[nodiscard]]
+        auto schedule() const noexcept -> schedule_task {
+            return schedule_task{channel_};
+        }
+    };
+
+    // `capacity` bounds the continuations one drain can be behind by before
+    // they take the direct path; rounded up to a power of two
+    handoff_channel(loop::doca_pe_run_loop& source, Scheduler destination, size_t capacity = 1024)
+        : source_(&source), destination_(std::move(destination)), ring_(capacity) {
+        hook_.run = &flush_;
+    }
+
+    handoff_channel(doca_pe_context& source, Scheduler destination, size_t capacity = 1024)
+        : handoff_channel(source.get_loop(), std::move(destination), capacity) {}
+
+    handoff_channel(const handoff_channel&) = delete;
+    handoff_channel& operator=(const handoff_channel&) = delete;
+
+    ~handoff_channel() {
+        // a drain may still be returning from its last check of the ring
+        while (drain_scheduled_.load(std::memory_order_acquire) || draining_.load(std::memory_order_acquire) != 0) {
+            std::this_thread::yield();
+        }
+    }
+
+    [[nodiscard]]
+    auto get_scheduler() noexcept -> scheduler {
+        return scheduler{this};
+    }
+
+    [[nodiscard]]
+    auto stats() const noexcept -> handoff_stats {
+        return {
+            .handed_off = handed_off_.load(),
+            .bypassed = bypassed_.load(std::memory_order_relaxed),
+            .wakeups = wakeups_.load(),
+        };
+    }
+
+private:
+    struct hook : loop::pass_hook {
+        handoff_channel* channel_ = nullptr;
+    };
+
+    // PE thread only
+    bool try_enqueue_(item* op) noexcept {
+        if (!source_->on_loop_thread() || !ring_.try_push(op)) {
+            return false;
+        }
+        handed_off_.add(1);
+        source_->defer_to_pass_end(hook_);
+        return true;
+    }
+
+    // runs on the PE thread at the end of the pass that enqueued something
+    static void flush_(loop::pass_hook* h) noexcept {
+        auto* self = static_cast<hook*>(h)->channel_;
+        // Pairs with the fence in drain_(): either the drain sees what this
+        // pass pushed, or this sees that the drain has finished.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (self->drain_scheduled_.load(std::memory_order_relaxed) ||
+            self->drain_scheduled_.exchange(true, std::memory_order_acquire)) {
+            return;
+        }
+
+        self->wakeups_.add(1);
+        try {
+            stdexec::start_detached(stdexec::schedule(self->destination_) |
+                                    stdexec::then([self] { self->drain_(false); }) |
+                                    stdexec::upon_error([self](auto&&) noexcept { self->drain_(true); }) |
+                                    stdexec::upon_stopped([self] { self->drain_(true); }));
+        } catch (...) {
+            // retry at the end of the next pass
+            self->drain_scheduled_.store(false, std::memory_order_relaxed);
+            self->source_->defer_to_pass_end(self->hook_);
+        }
+    }
+
+    // The single consumer. A destination that refuses the drain stops
+    // every continuation queued rather than running them on the wrong thread.
+    void drain_(bool stopped) noexcept {
+        draining_.fetch_add(1, std::memory_order_relaxed);
+        do {
+            while (ring_.consume_all([stopped](item* op) { op->deliver(op, stopped); }) > 0) {
+            }
+            drain_scheduled_.store(false, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+        } while (!ring_.empty() && !drain_scheduled_.exchange(true, std::memory_order_acquire));
+        draining_.fetch_sub(1, std::memory_order_release);
+    }
+
+    loop::doca_pe_run_loop* source_;
+    Scheduler destination_;
+    spsc_ring<item*> ring_;
+    hook hook_{{}, this};
+
+    // written by the PE thread
+    alignas(cache_line_size) loop::counter handed_off_;
+    loop::counter wakeups_;
+
+    // set while a drain is scheduled or running, cleared by the drain
+    alignas(cache_line_size) std::atomic<bool> drain_scheduled_ = false;
+    std::atomic<uint32_t> draining_ = 0;
+    std::atomic<uint64_t> bypassed_ = 0;
+};
+
+} // namespace doca_stdexec
+
+#endif // DOCA_STDEXEC_HANDOFF_HPP
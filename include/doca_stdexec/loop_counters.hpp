@@ -0,0 +1,117 @@
+#pragma once
+#ifndef DOCA_STDEXEC_LOOP_COUNTERS_HPP
+#define DOCA_STDEXEC_LOOP_COUNTERS_HPP
+
+#include "doca_stdexec/common/cycle_clock.hpp"
+#include "doca_stdexec/common/mpsc_queue.hpp"
+#include "doca_stdexec/priority.hpp"
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace doca_stdexec::loop {
+
+/**
+ * @brief Counter written by one thread and read by any
+ *
+ * Updates are a plain load and store, never a read-modify-write, so an
+ * event costs at most one store to a line the writer already owns.
+ */
+struct counter {
+    std::atomic<uint64_t> value = 0;
+
+    void add(uint64_t n) noexcept {
+        value.store(value.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+
+    // for high-water marks, stores only when `n` is a new maximum
+    void raise_to(uint64_t n) noexcept {
+        if (n > value.load(std::memory_order_relaxed)) {
+            value.store(n, std::memory_order_relaxed);
+        }
+    }
+
+    uint64_t load() const noexcept {
+        return value.load(std::memory_order_relaxed);
+    }
+};
+
+/**
+ * @brief Counters of one run loop, written by its PE thread only
+ *
+ * Split from the loop so that DOCA task operations, which are defined before
+ * it, can report submissions and completions to the loop of the thread they
+ * run on through `current`.
+ */
+struct alignas(cache_line_size) run_loop_counters {
+    counter passes;
+    counter tasks_inlined;
+    counter tasks_executed;
+    counter remote_batches;
+    counter remote_tasks;
+    counter task_budget_exhausted;
+    counter task_slice_exhausted;
+    counter productive_polls;
+    counter empty_polls;
+    counter completion_budget_exhausted;
+    counter completion_slice_exhausted;
+    counter timers_fired;
+    std::array<counter, priority_count> tasks_by_priority;
+
+    counter local_queue_high_water;
+    counter remote_batch_high_water;
+
+    counter doca_tasks_submitted;
+    counter doca_tasks_completed;
+    counter doca_tasks_in_flight_high_water;
+
+    // in cycle_clock ticks
+    counter task_ticks;
+    counter receiver_ticks;
+    counter poll_ticks;
+    counter sleep_ticks;
+
+    // writer-side state behind the high-water marks
+    uint64_t local_queue_depth = 0;
+    uint64_t doca_tasks_in_flight = 0;
+
+    // counters of the loop being run by this thread, if any
+    static inline thread_local run_loop_counters* current = nullptr;
+
+    void task_submitted() noexcept {
+        doca_tasks_submitted.add(1);
+        doca_tasks_in_flight_high_water.raise_to(++doca_tasks_in_flight);
+    }
+};
+
+/**
+ * @brief Accounts one DOCA task completion callback, including the receiver
+ *        it runs, to the loop of the calling thread
+ */
+class completion_scope {
+public:
+    completion_scope() noexcept
+        : counters_(run_loop_counters::current), begin_(counters_ != nullptr ? cycle_clock::now() : 0) {}
+
+    completion_scope(const completion_scope&) = delete;
+    completion_scope& operator=(const completion_scope&) = delete;
+
+    ~completion_scope() {
+        if (counters_ != nullptr) {
+            counters_->receiver_ticks.add(cycle_clock::now() - begin_);
+            counters_->doca_tasks_completed.add(1);
+            // tasks submitted outside of a run loop were never counted
+            if (counters_->doca_tasks_in_flight > 0) {
+                counters_->doca_tasks_in_flight--;
+            }
+        }
+    }
+
+private:
+    run_loop_counters* counters_;
+    uint64_t begin_;
+};
+
+} // namespace doca_stdexec::loop
+
+#endif // DOCA_STDEXEC_LOOP_COUNTERS_HPP
@@ -0,0 +1,318 @@
+#pragma once
+#ifndef DOCA_STDEXEC_MULTIPLEXER_HPP
+#define DOCA_STDEXEC_MULTIPLEXER_HPP
+
+#include "doca_stdexec/context.hpp"
+#include "doca_stdexec/progress_engine.hpp"
+#include "doca_stdexec/trace.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <optional>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <system_error>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace doca_stdexec {
+
+struct multiplexer_options {
+    size_t num_threads = 1;
+    // thread i is pinned to cpus[i % cpus.size()], empty leaves them unpinned
+    std::vector<int> cpus;
+    // passes an engine runs per round while it has work, by engine index;
+    // engines beyond the end get 1
+    std::vector<unsigned> shares;
+    // an engine without work for this long is parked on its notification
+    // until a completion or a scheduled task arrives
+    std::chrono::microseconds idle_window{50};
+    // budgets of every engine's passes; mode and spin_window are unused
+    loop::run_loop_options loop_options{};
+};
+
+/**
+ * @brief Drives many ProgressEngines, each with its own run loop, from a
+ *        few threads
+ *
+ * Meant for hosts with more tenants than cores, each tenant with its own PE
+ * and Rdma context, where a doca_pe_context thread per tenant would leave
+ * most threads idle. Engine i is driven by thread i % num_threads, which
+ * visits its engines round-robin and gives each up to its share of passes
+ * per round, stopping early at a pass that found nothing to do.
+ *
+ * An engine idle for idle_window is parked: its PE notification is armed
+ * and the thread skips it until its notification fd fires or its next
+ * timer is due. A thread whose engines are all parked blocks on all their
+ * fds at once, so parked tenants cost nothing and still wake within one
+ * epoll_wait of their next completion.
+ *
+ * Everything the run loop offers works per engine: schedulers, timers,
+ * stats. Work on an engine's DOCA objects must be scheduled on its
+ * scheduler, as with a dedicated thread.
+ */
+class pe_multiplexer {
+    struct engine {
+        run_loop loop;
+        unsigned share;
+        bool parked = false;
+        std::chrono::steady_clock::time_point last_work;
+        // when a parked engine's next timer is due
+        std::optional<std::chrono::steady_clock::time_point> wake_at;
+
+        engine(loop::run_loop_options options, unsigned share)
+            : loop(ProgressEngine{}, options), share(std::max(share, 1u)) {}
+    };
+
+    struct driver {
+        std::vector<engine*> engines;
+        pe_thread_options thread_options;
+        int epoll_fd = -1;
+        int stop_fd = -1;
+        std::thread thread;
+
+        ~driver() {
+            if (epoll_fd >= 0) {
+                close(epoll_fd);
+            }
+            if (stop_fd >= 0) {
+                close(stop_fd);
+            }
+        }
+    };
+
+public:
+    pe_multiplexer(size_t num_engines, multiplexer_options options) : idle_window_(options.idle_window) {
+        if (num_engines == 0 || options.num_threads == 0) {
+            check_error(DOCA_ERROR_INVALID_VALUE, "Multiplexer needs at least one engine and one thread");
+        }
+
+        engines_.reserve(num_engines);
+        for (size_t i = 0; i < num_engines; i++) {
+            auto share = i < options.shares.size() ? options.shares[i] : 1u;
+            engines_.emplace_back(std::make_unique<engine>(options.loop_options, share));
+        }
+
+        auto num_threads = std::min(options.num_threads, num_engines);
+        drivers_.reserve(num_threads);
+        for (size_t t = 0; t < num_threads; t++) {
+            auto& d = *drivers_.emplace_back(std::make_unique<driver>());
+            if (!options.cpus.empty()) {
+                d.thread_options.cpu = options.cpus[t % options.cpus.size()];
+            }
+            for (size_t i = t; i < num_engines; i += num_threads) {
+                d.engines.push_back(engines_[i].get());
+            }
+            open_fds_(d);
+        }
+
+        std::vector<std::future<void>> applied;
+        applied.reserve(drivers_.size());
+        for (auto& d : drivers_) {
+            std::promise<void> ready;
+            applied.push_back(ready.get_future());
+            d->thread = std::thread([this, raw = d.get(), ready = std::move(ready)]() mutable { drive_(*raw, ready); });
+        }
+        // thread options that cannot be applied fail the constructor
+        try {
+            for (auto& a : applied) {
+                a.get();
+            }
+        } catch (...) {
+            stop_drivers_();
+            throw;
+        }
+    }
+
+    explicit pe_multiplexer(size_t num_engines) : pe_multiplexer(num_engines, multiplexer_options{}) {}
+
+    pe_multiplexer(const pe_multiplexer&) = delete;
+    pe_multiplexer& operator=(const pe_multiplexer&) = delete;
+
+    ~pe_multiplexer() {
+        stop_drivers_();
+    }
+
+    [[nodiscard]]
+    size_t num_engines() const noexcept {
+        return engines_.size();
+    }
+
+    [[nodiscard]]
+    size_t num_threads() const noexcept {
+        return drivers_.size();
+    }
+
+    auto get_scheduler(size_t engine, priority priority = priority::normal) noexcept {
+        return engines_[engine]->loop.get_scheduler(priority);
+    }
+
+    // call from the engine's scheduler, like doca_pe_context::connect_ctx
+    auto connect_ctx(size_t engine, std::shared_ptr<Context> ctx) {
+        return engines_[engine]->loop.connect_ctx(std::move(ctx));
+    }
+
+    [[nodiscard]]
+    loop::run_loop_stats stats(size_t engine) const noexcept {
+        return engines_[engine]->loop.stats();
+    }
+
+private:
+    static void open_fds_(driver& d) {
+        auto fail = [](const char* what) { throw std::system_error(errno, std::system_category(), what); };
+
+        d.epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+        if (d.epoll_fd < 0) {
+            fail("Failed to create multiplexer epoll fd");
+        }
+        d.stop_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (d.stop_fd < 0) {
+            fail("Failed to create multiplexer stop eventfd");
+        }
+
+        epoll_event event{.events = EPOLLIN, .data = {.ptr = nullptr}};
+        if (epoll_ctl(d.epoll_fd, EPOLL_CTL_ADD, d.stop_fd, &event) < 0) {
+            fail("Failed to add stop eventfd to epoll");
+        }
+        // a loop's notification fd is an epoll fd itself, readable while
+        // anything inside it is
+        for (auto* e : d.engines) {
+            event = epoll_event{.events = EPOLLIN, .data = {.ptr = e}};
+            if (epoll_ctl(d.epoll_fd, EPOLL_CTL_ADD, e->loop.get_notification_fd(), &event) < 0) {
+                fail("Failed to add run loop notification fd to epoll");
+            }
+        }
+    }
+
+    void stop_drivers_() noexcept {
+        stop_.store(true, std::memory_order_seq_cst);
+        for (auto& d : drivers_) {
+            uint64_t one = 1;
+            [[maybe_unused]] auto written = write(d->stop_fd, &one, sizeof(one));
+        }
+        for (auto& d : drivers_) {
+            d->thread.join();
+        }
+    }
+
+    void drive_(driver& d, std::promise<void>& applied) {
+        trace::set_thread_name("pe-mux");
+        if (!apply_thread_options(d.thread_options, applied)) {
+            return;
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        for (auto* e : d.engines) {
+            e->last_work = now;
+        }
+
+        size_t parked = 0;
+        while (!stop_.load(std::memory_order_acquire)) {
+            for (auto* e : d.engines) {
+                if (e->parked) {
+                    continue;
+                }
+
+                bool worked = false;
+                for (unsigned pass = 0; pass < e->share && e->loop.poll_once(); pass++) {
+                    worked = true;
+                }
+
+                now = std::chrono::steady_clock::now();
+                if (worked) {
+                    e->last_work = now;
+                } else if (now - e->last_work >= idle_window_) {
+                    // arming polls the PE one last time; after that nothing
+                    // runs on the loop until it is unparked and the
+                    // notification cleared
+                    if (e->loop.arm_notification()) {
+                        e->parked = true;
+                        e->wake_at = e->loop.next_timer_deadline();
+                        parked++;
+                    } else {
+                        e->last_work = now;
+                    }
+                }
+            }
+
+            // with some engines still active this is one non-blocking
+            // epoll_wait per round
+            if (parked > 0) {
+                parked -= wait_(d, parked == d.engines.size());
+            }
+        }
+
+        for (auto* e : d.engines) {
+            if (e->parked) {
+                e->loop.clear_notification();
+            }
+        }
+    }
+
+    // Unparks the engines whose fd fired or whose timer is due, blocking
+    // until one does if `block`; returns how many were unparked.
+    size_t wait_(driver& d, bool block) {
+        std::optional<timespec> timeout = timespec{};
+        if (block) {
+            timeout.reset();
+            std::optional<std::chrono::steady_clock::time_point> earliest;
+            for (auto* e : d.engines) {
+                if (e->wake_at && (!earliest || *e->wake_at < *earliest)) {
+                    earliest = e->wake_at;
+                }
+            }
+            if (earliest) {
+                auto wait = std::max(*earliest - std::chrono::steady_clock::now(),
+                                     std::chrono::steady_clock::duration::zero());
+                auto seconds = std::chrono::floor<std::chrono::seconds>(wait);
+                timeout = timespec{.tv_sec = static_cast<time_t>(seconds.count()),
+                                   .tv_nsec = static_cast<long>(std::chrono::nanoseconds(wait - seconds).count())};
+            }
+        }
+
+        epoll_event events[16];
+        int ready;
+        while ((ready = epoll_pwait2(d.epoll_fd, events, 16, timeout ? &*timeout : nullptr, nullptr)) < 0 &&
+               errno == EINTR) {
+        }
+
+        size_t unparked = 0;
+        auto unpark = [&](engine* e) {
+            if (e->parked) {
+                e->loop.clear_notification();
+                e->parked = false;
+                e->wake_at.reset();
+                e->last_work = std::chrono::steady_clock::now();
+                unparked++;
+            }
+        };
+
+        for (int i = 0; i < ready; i++) {
+            if (auto* e = static_cast<engine*>(events[i].data.ptr)) {
+                unpark(e);
+            }
+        }
+        auto now = std::chrono::steady_clock::now();
+        for (auto* e : d.engines) {
+            if (e->wake_at && *e->wake_at <= now) {
+                unpark(e);
+            }
+        }
+        return unparked;
+    }
+
+    std::chrono::microseconds idle_window_;
+    std::vector<std::unique_ptr<engine>> engines_;
+    std::vector<std::unique_ptr<driver>> drivers_;
+    std::atomic<bool> stop_ = false;
+};
+
+} // namespace doca_stdexec
+
+#endif // DOCA_STDEXEC_MULTIPLEXER_HPP
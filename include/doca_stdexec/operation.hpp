@@ -12,6 +12,15 @@ struct immovable {
   immovable(immovable&&) = delete;
 };
 
+// constructs a non-movable T in place from the result of `fn`, e.g. an
+// operation state in an optional or a variant
+template <typename T, typename Fn>
+struct emplace_from {
+  Fn fn;
+
+  operator T() && { return static_cast<Fn&&>(fn)(); }
+};
+
 } // namespace doca_stdexec
 
 #endif // DOCA_STDEXEC_OPERATION_HPP
\ No newline at end of file
@@ -0,0 +1,30 @@
+#pragma once
+#ifndef DOCA_STDEXEC_PRIORITY_HPP
+#define DOCA_STDEXEC_PRIORITY_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace doca_stdexec {
+
+/**
+ * @brief Priority class of work scheduled on a run loop
+ *
+ * Control-plane work (connection setup, metadata RPCs, pings) belongs in
+ * high so that it does not queue behind bulk data continuations.
+ */
+enum class priority : uint8_t {
+    high,
+    normal,
+    low,
+};
+
+inline constexpr size_t priority_count = 3;
+
+inline constexpr size_t index_of(priority p) noexcept {
+    return static_cast<size_t>(p);
+}
+
+} // namespace doca_stdexec
+
+#endif // DOCA_STDEXEC_PRIORITY_HPP
@@ -1,16 +1,40 @@
 #pragma once
-#include "rdma/task.hpp"
 #include <memory>
 #ifndef DOCA_STDEXEC_PE_HPP
 #define DOCA_STDEXEC_PE_HPP
 
+#include "doca_stdexec/common/mpsc_queue.hpp"
+#include "doca_stdexec/common/timer_wheel.hpp"
 #include "doca_stdexec/context.hpp"
+#include "doca_stdexec/device.hpp"
+#include "doca_stdexec/doorbell.hpp"
+#include "doca_stdexec/frame_pool.hpp"
+#include "doca_stdexec/loop_counters.hpp"
+#include "doca_stdexec/priority.hpp"
+#include "doca_stdexec/topology.hpp"
+#include "doca_stdexec/trace.hpp"
+#include "doca_stdexec/work_stealing.hpp"
 #include "operation.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
 #include <cstdint>
 #include <doca_pe.h>
+#include <future>
+#include <optional>
+#include <pthread.h>
+#include <sched.h>
 #include <stdexec/execution.hpp>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <system_error>
 #include <thread>
+#include <unistd.h>
 #include <utility>
+#include <variant>
+#include <vector>
 
 namespace doca_stdexec {
 
@@ -34,12 +58,6 @@ public:
     }
     ~ProgressEngine() = default;
 
-    auto connect_ctx(std::shared_ptr<Context> ctx) {
-        auto ctx_ptr = ctx->as_ctx();
-        ctxs_.emplace_back(std::move(ctx));
-        return doca_pe_connect_ctx(pe_.get(), ctx_ptr);
-    }
-
     doca_pe* get() noexcept {
         return pe_.get();
     }
@@ -48,7 +66,33 @@ public:
         return doca_pe_progress(pe_.get());
     }
 
+    doca_notification_handle_t get_notification_handle() {
+        doca_notification_handle_t handle;
+        auto status = doca_pe_get_notification_handle(pe_.get(), &handle);
+        check_error(status, "Failed to get pe notification handle");
+        return handle;
+    }
+
+    void request_notification() {
+        auto status = doca_pe_request_notification(pe_.get());
+        check_error(status, "Failed to request pe notification");
+    }
+
+    void clear_notification(doca_notification_handle_t handle = 0) {
+        auto status = doca_pe_clear_notification(pe_.get(), handle);
+        check_error(status, "Failed to clear pe notification");
+    }
+
 private:
+    // only through the run loop, which the context's senders complete on
+    friend class loop::doca_pe_run_loop;
+
+    auto connect_ctx(std::shared_ptr<Context> ctx) {
+        auto ctx_ptr = ctx->as_ctx();
+        ctxs_.emplace_back(std::move(ctx));
+        return doca_pe_connect_ctx(pe_.get(), ctx_ptr);
+    }
+
     std::unique_ptr<doca_pe, doca_pe_deleter> pe_;
     std::vector<std::shared_ptr<Context>> ctxs_;
 };
@@ -57,20 +101,248 @@ private:
 // run_loop
 namespace loop {
 class doca_pe_run_loop;
+struct domain;
+
+enum class progress_mode {
+    // poll the PE and the task queue forever
+    spin,
+    // poll for spin_window after the last useful work, then block until a
+    // completion or a newly scheduled task arrives
+    adaptive,
+};
 
-struct task : immovable {
-    task* next = this;
+enum class priority_policy {
+    // always run the highest pending priority first; lower classes only run
+    // while the higher ones are empty and may starve under sustained load
+    strict,
+    // share each pass by priority_weights, highest first within a round, so
+    // that lower classes keep making progress
+    weighted,
+};
 
-    union {
-        task* tail = nullptr;
-        void (*execute_)(task*) noexcept;
-    };
+struct run_loop_options {
+    progress_mode mode = progress_mode::spin;
+    std::chrono::microseconds spin_window{100};
+
+    // Budgets of one pass of the loop, which runs scheduled tasks, then
+    // polls the PE for completions, then fires timers. Bounding each phase
+    // keeps a flood of tasks from starving completions and vice versa.
+    // 0 means unbounded.
+    size_t max_tasks_per_pass = 256;
+    // counts doca_pe_progress() calls that made progress
+    size_t max_completions_per_pass = 256;
+    // ends a phase early once it has run this long, 0 disables the check
+    std::chrono::nanoseconds time_slice{0};
+
+    // schedule() started on the PE thread itself completes inline, up to
+    // this many nested levels before falling back to the queue; 0 disables
+    unsigned max_inline_depth = 16;
+
+    priority_policy dequeue_policy = priority_policy::strict;
+    // tasks per round for high, normal and low under priority_policy::weighted
+    std::array<unsigned, priority_count> priority_weights{16, 4, 1};
+};
+
+/**
+ * @brief Per-phase counters of a run loop, for tuning the pass budgets and
+ *        sizing the number of PE threads
+ */
+struct run_loop_stats {
+    uint64_t passes = 0;
+
+    // schedule() operations completed inline on the PE thread
+    uint64_t tasks_inlined = 0;
+
+    // task phase
+    uint64_t tasks_executed = 0;
+    // batches taken from the remote queue and the tasks in them
+    uint64_t remote_batches = 0;
+    uint64_t remote_tasks = 0;
+    // passes that left tasks behind because max_tasks_per_pass was hit
+    uint64_t task_budget_exhausted = 0;
+    uint64_t task_slice_exhausted = 0;
+
+    // completion phase
+    uint64_t productive_polls = 0;
+    uint64_t empty_polls = 0;
+    uint64_t completion_budget_exhausted = 0;
+    uint64_t completion_slice_exhausted = 0;
+
+    // timer phase
+    uint64_t timers_fired = 0;
+
+    // tasks executed per priority class, indexed by index_of(priority)
+    std::array<uint64_t, priority_count> tasks_by_priority{};
+
+    // most tasks waiting in the local queue at once, and the largest batch
+    // taken from the remote queue
+    uint64_t local_queue_high_water = 0;
+    uint64_t remote_batch_high_water = 0;
+
+    // DOCA tasks submitted from the PE thread and their completions; the
+    // in-flight count is a gauge at the time of the snapshot
+    uint64_t doca_tasks_submitted = 0;
+    uint64_t doca_tasks_completed = 0;
+    uint64_t doca_tasks_in_flight = 0;
+    uint64_t doca_tasks_in_flight_high_water = 0;
+
+    // Where the PE thread's time went: running scheduled tasks and timers,
+    // running DOCA task completions and the receivers they complete, inside
+    // doca_pe_progress() otherwise, and blocked waiting for work.
+    std::chrono::nanoseconds task_time{0};
+    std::chrono::nanoseconds receiver_time{0};
+    std::chrono::nanoseconds poll_time{0};
+    std::chrono::nanoseconds sleep_time{0};
+
+    // blocks for coroutine frames and detached operation states the loop's
+    // frame pool took from the heap, and those it served from its free lists
+    uint64_t frames_allocated = 0;
+    uint64_t frames_recycled = 0;
+
+    /**
+     * @brief Share of the thread's time spent running tasks and receivers,
+     *        as opposed to polling without result or sleeping
+     */
+    [[nodiscard]]
+    double utilization() const noexcept {
+        auto busy = task_time + receiver_time;
+        auto total = busy + poll_time + sleep_time;
+        return total.count() > 0 ? static_cast<double>(busy.count()) / static_cast<double>(total.count()) : 0.0;
+    }
+
+    /**
+     * @brief Activity since `earlier`, an older snapshot of the same loop;
+     *        gauges and high-water marks are kept as they are
+     */
+    [[nodiscard]]
+    run_loop_stats since(const run_loop_stats& earlier) const noexcept {
+        auto window = *this;
+        window.passes -= earlier.passes;
+        window.tasks_inlined -= earlier.tasks_inlined;
+        window.tasks_executed -= earlier.tasks_executed;
+        window.remote_batches -= earlier.remote_batches;
+        window.remote_tasks -= earlier.remote_tasks;
+        window.task_budget_exhausted -= earlier.task_budget_exhausted;
+        window.task_slice_exhausted -= earlier.task_slice_exhausted;
+        window.productive_polls -= earlier.productive_polls;
+        window.empty_polls -= earlier.empty_polls;
+        window.completion_budget_exhausted -= earlier.completion_budget_exhausted;
+        window.completion_slice_exhausted -= earlier.completion_slice_exhausted;
+        window.timers_fired -= earlier.timers_fired;
+        for (size_t i = 0; i < priority_count; i++) {
+            window.tasks_by_priority[i] -= earlier.tasks_by_priority[i];
+        }
+        window.doca_tasks_submitted -= earlier.doca_tasks_submitted;
+        window.doca_tasks_completed -= earlier.doca_tasks_completed;
+        window.task_time -= earlier.task_time;
+        window.receiver_time -= earlier.receiver_time;
+        window.poll_time -= earlier.poll_time;
+        window.sleep_time -= earlier.sleep_time;
+        window.frames_allocated -= earlier.frames_allocated;
+        window.frames_recycled -= earlier.frames_recycled;
+        return window;
+    }
+};
+
+struct task : immovable {
+    std::atomic<task*> next{nullptr};
+    void (*execute_)(task*) noexcept = nullptr;
 
     void execute() noexcept {
         (*execute_)(this);
     }
 };
 
+/**
+ * @brief Work the PE thread defers to the end of the current pass
+ *
+ * Lets a component collect what the completions of one pass produce and act
+ * on the whole batch once, e.g. wake a consumer thread a single time.
+ */
+struct pass_hook {
+    pass_hook* next = nullptr;
+    bool queued = false;
+    void (*run)(pass_hook*) noexcept = nullptr;
+};
+
+// a task ordered earliest-deadline-first within its priority class
+struct deadline_task : task {
+    std::chrono::steady_clock::time_point deadline;
+    priority priority_ = priority::normal;
+};
+
+using work_stealing_group = basic_work_stealing_group<task>;
+
+/**
+ * @brief Tasks of one priority class waiting on the PE thread
+ *
+ * Deadline tasks wait in a min-heap and run ahead of the FIFO of all other
+ * tasks, earliest deadline first and in scheduling order among equal ones.
+ */
+class class_queue {
+public:
+    void push(task* task) noexcept {
+        fifo_.push(task);
+    }
+
+    // may allocate when the heap grows
+    void push(deadline_task* task) {
+        heap_.push_back(entry{task->deadline, sequence_++, task});
+        std::push_heap(heap_.begin(), heap_.end(), later_);
+    }
+
+    // receives batches taken from a remote queue
+    intrusive_queue<task>& fifo() noexcept {
+        return fifo_;
+    }
+
+    task* pop() noexcept {
+        if (!heap_.empty()) {
+            std::pop_heap(heap_.begin(), heap_.end(), later_);
+            auto* task = heap_.back().task;
+            heap_.pop_back();
+            return task;
+        }
+        return fifo_.pop();
+    }
+
+    bool empty() const noexcept {
+        return heap_.empty() && fifo_.empty();
+    }
+
+private:
+    struct entry {
+        std::chrono::steady_clock::time_point deadline;
+        uint64_t sequence;
+        deadline_task* task;
+    };
+
+    static bool later_(const entry& a, const entry& b) noexcept {
+        return a.deadline != b.deadline ? a.deadline > b.deadline : a.sequence > b.sequence;
+    }
+
+    intrusive_queue<task> fifo_;
+    std::vector<entry> heap_;
+    uint64_t sequence_ = 0;
+};
+
+namespace detail {
+
+template <class Receiver>
+void complete_schedule(Receiver& rcvr) noexcept {
+    try {
+        if (stdexec::get_stop_token(stdexec::get_env(rcvr)).stop_requested()) {
+            stdexec::set_stopped(static_cast<Receiver&&>(rcvr));
+        } else {
+            stdexec::set_value(static_cast<Receiver&&>(rcvr));
+        }
+    } catch (...) {
+        stdexec::set_error(static_cast<Receiver&&>(rcvr), std::current_exception());
+    }
+}
+
+} // namespace detail
+
 template <class ReceiverId>
 struct operation {
     using Receiver = stdexec::__t<ReceiverId>;
@@ -79,26 +351,92 @@ struct operation {
         using id = operation;
 
         doca_pe_run_loop* loop_{};
+        bool stealable_ = false;
+        priority priority_ = priority::normal;
         [[no_unique_address]] Receiver rcvr_;
 
         static void execute_impl(task* p) noexcept {
-            auto& rcvr = static_cast<t*>(p)->rcvr_;
-            try {
-                if (stdexec::get_stop_token(stdexec::get_env(rcvr)).stop_requested()) {
-                    stdexec::set_stopped(static_cast<Receiver&&>(rcvr));
-                } else {
-                    stdexec::set_value(static_cast<Receiver&&>(rcvr));
-                }
-            } catch (...) {
-                stdexec::set_error(static_cast<Receiver&&>(rcvr), std::current_exception());
-            }
+            detail::complete_schedule(static_cast<t*>(p)->rcvr_);
         }
 
-        explicit t(task* tail) noexcept : task{{}, this, tail} {}
+        t(doca_pe_run_loop* loop, bool stealable, priority priority, Receiver rcvr)
+            : task{}, loop_{loop}, stealable_{stealable}, priority_{priority}, rcvr_{static_cast<Receiver&&>(rcvr)} {
+            execute_ = &execute_impl;
+        }
+
+        void start() & noexcept;
+    };
+};
+
+template <class ReceiverId>
+struct deadline_operation {
+    using Receiver = stdexec::__t<ReceiverId>;
+
+    struct t : deadline_task {
+        using id = deadline_operation;
+
+        doca_pe_run_loop* loop_{};
+        [[no_unique_address]] Receiver rcvr_;
 
-        t(task* next, doca_pe_run_loop* loop, Receiver rcvr)
-            : task{{}, next, {}}, loop_{loop}, rcvr_{static_cast<Receiver&&>(rcvr)} {
+        static void execute_impl(task* p) noexcept {
+            detail::complete_schedule(static_cast<t*>(p)->rcvr_);
+        }
+
+        t(doca_pe_run_loop* loop, priority priority, std::chrono::steady_clock::time_point deadline, Receiver rcvr)
+            : deadline_task{}, loop_{loop}, rcvr_{static_cast<Receiver&&>(rcvr)} {
             execute_ = &execute_impl;
+            this->deadline = deadline;
+            priority_ = priority;
+        }
+
+        void start() & noexcept;
+    };
+};
+
+template <class ReceiverId>
+struct timer_operation {
+    using Receiver = stdexec::__t<ReceiverId>;
+    using stop_token_t = stdexec::stop_token_of_t<stdexec::env_of_t<Receiver>>;
+
+    struct t : task, timer_node {
+        using id = timer_operation;
+
+        struct on_stop {
+            t* self_;
+
+            void operator()() const noexcept;
+        };
+
+        struct cancel_task : task {
+            t* self_ = nullptr;
+        };
+
+        doca_pe_run_loop* loop_{};
+        std::chrono::steady_clock::time_point deadline_;
+        // for schedule_after, the deadline is taken in start()
+        std::optional<std::chrono::steady_clock::duration> delay_;
+        [[no_unique_address]] Receiver rcvr_;
+        // queued by on_stop, disarms the timer on the PE thread
+        cancel_task cancel_;
+        std::optional<stdexec::stop_callback_for_t<stop_token_t, on_stop>> on_stop_;
+        std::atomic<bool> cancel_requested_ = false;
+
+        // runs on the PE thread, which owns the timer wheel
+        static void arm_impl(task* p) noexcept;
+        static void fire_impl(timer_node* node) noexcept;
+        static void cancel_impl(task* p) noexcept;
+
+        t(doca_pe_run_loop* loop, std::chrono::steady_clock::time_point deadline, Receiver rcvr)
+            : task{}, loop_{loop}, deadline_{deadline}, rcvr_{static_cast<Receiver&&>(rcvr)} {
+            execute_ = &arm_impl;
+            fire = &fire_impl;
+            cancel_.execute_ = &cancel_impl;
+            cancel_.self_ = this;
+        }
+
+        t(doca_pe_run_loop* loop, std::chrono::steady_clock::duration delay, Receiver rcvr)
+            : t(loop, std::chrono::steady_clock::time_point{}, static_cast<Receiver&&>(rcvr)) {
+            delay_ = delay;
         }
 
         void start() & noexcept;
@@ -109,6 +447,12 @@ class doca_pe_run_loop {
     template <class>
     friend struct operation;
 
+    template <class>
+    friend struct timer_operation;
+
+    template <class>
+    friend struct deadline_operation;
+
 public:
     struct scheduler {
     private:
@@ -124,7 +468,7 @@ public:
             using operation = operation<stdexec::__id<Receiver>>::t;
 
             auto connect(stdexec::receiver auto rcvr) const -> operation<decltype(rcvr)> {
-                return {&loop_->head, loop_, static_cast<decltype(rcvr)&&>(rcvr)};
+                return {loop_, stealable_, priority_, static_cast<decltype(rcvr)&&>(rcvr)};
             }
 
             template <class... Env>
@@ -140,37 +484,149 @@ public:
                 using id = env;
 
                 doca_pe_run_loop* loop_;
+                bool stealable_;
+                priority priority_;
 
                 template <class CPO>
                 auto query(stdexec::get_completion_scheduler_t<CPO>) const noexcept -> scheduler {
-                    return loop_->get_scheduler();
+                    return scheduler{loop_, stealable_, priority_};
                 }
             };
 
-            struct domain {
-                template <typename Sender, typename Env>
-                auto transform_sender(domain, Sender&& snd, const Env& env) {
-                    printf("Transforming sender\n");
-                    return std::forward<Sender>(snd);
-                }
-            };
+            schedule_task(doca_pe_run_loop* loop, bool stealable, priority priority) noexcept
+                : loop_(loop), stealable_(stealable), priority_(priority) {}
+
+            doca_pe_run_loop* const loop_;
+            const bool stealable_;
+            const priority priority_;
+
+        public:
+            [[nodiscard]]
+            auto get_env() const noexcept {
+                return env{loop_, stealable_, priority_};
+            }
+        };
+
+        struct schedule_before_task {
+            using t = schedule_before_task;
+            using id = schedule_before_task;
+            using sender_concept = stdexec::sender_t;
+            using completion_signatures =
+                stdexec::completion_signatures<stdexec::set_value_t(), stdexec::set_error_t(std::exception_ptr),
+                                               stdexec::set_stopped_t()>;
+
+            template <class Receiver>
+            using operation = deadline_operation<stdexec::__id<Receiver>>::t;
+
+            auto connect(stdexec::receiver auto rcvr) const -> operation<decltype(rcvr)> {
+                return {loop_, priority_, deadline_, static_cast<decltype(rcvr)&&>(rcvr)};
+            }
+
+            template <class... Env>
+            friend auto get_completion_signatures(const schedule_before_task&, Env&&...) -> completion_signatures {
+                return {};
+            }
+
+        private:
+            friend scheduler;
+
+            schedule_before_task(doca_pe_run_loop* loop, priority priority,
+                                 std::chrono::steady_clock::time_point deadline) noexcept
+                : loop_(loop), priority_(priority), deadline_(deadline) {}
+
+            doca_pe_run_loop* const loop_;
+            const priority priority_;
+            const std::chrono::steady_clock::time_point deadline_;
+
+        public:
+            [[nodiscard]]
+            auto get_env() const noexcept {
+                return schedule_task::env{loop_, false, priority_};
+            }
+        };
+
+        struct schedule_at_task {
+            using t = schedule_at_task;
+            using id = schedule_at_task;
+            using sender_concept = stdexec::sender_t;
+            using completion_signatures =
+                stdexec::completion_signatures<stdexec::set_value_t(), stdexec::set_stopped_t()>;
+
+            template <class Receiver>
+            using operation = timer_operation<stdexec::__id<Receiver>>::t;
+
+            auto connect(stdexec::receiver auto rcvr) const -> operation<decltype(rcvr)> {
+                return {loop_, deadline_, static_cast<decltype(rcvr)&&>(rcvr)};
+            }
+
+            template <class... Env>
+            friend auto get_completion_signatures(const schedule_at_task&, Env&&...) -> completion_signatures {
+                return {};
+            }
+
+        private:
+            friend scheduler;
+
+            schedule_at_task(doca_pe_run_loop* loop, std::chrono::steady_clock::time_point deadline) noexcept
+                : loop_(loop), deadline_(deadline) {}
+
+            doca_pe_run_loop* const loop_;
+            const std::chrono::steady_clock::time_point deadline_;
+
+        public:
+            [[nodiscard]]
+            auto get_env() const noexcept {
+                return schedule_task::env{loop_, false, priority::normal};
+            }
+        };
+
+        // Like schedule_at_task, with the deadline `delay_` after start(), so
+        // that one sender can be started again later, e.g. in a retry loop
+        struct schedule_after_task {
+            using t = schedule_after_task;
+            using id = schedule_after_task;
+            using sender_concept = stdexec::sender_t;
+            using completion_signatures =
+                stdexec::completion_signatures<stdexec::set_value_t(), stdexec::set_stopped_t()>;
 
-            explicit schedule_task(doca_pe_run_loop* loop) noexcept : loop_(loop) {}
+            template <class Receiver>
+            using operation = timer_operation<stdexec::__id<Receiver>>::t;
+
+            auto connect(stdexec::receiver auto rcvr) const -> operation<decltype(rcvr)> {
+                return {loop_, delay_, static_cast<decltype(rcvr)&&>(rcvr)};
+            }
+
+            template <class... Env>
+            friend auto get_completion_signatures(const schedule_after_task&, Env&&...) -> completion_signatures {
+                return {};
+            }
+
+        private:
+            friend scheduler;
+
+            schedule_after_task(doca_pe_run_loop* loop, std::chrono::steady_clock::duration delay) noexcept
+                : loop_(loop), delay_(delay) {}
 
             doca_pe_run_loop* const loop_;
+            const std::chrono::steady_clock::duration delay_;
 
         public:
             [[nodiscard]]
             auto get_env() const noexcept {
-                return env{loop_};
+                return schedule_task::env{loop_, false, priority::normal};
             }
         };
 
         friend doca_pe_run_loop;
 
-        explicit scheduler(doca_pe_run_loop* loop) noexcept : loop_(loop) {}
+        explicit scheduler(doca_pe_run_loop* loop, bool stealable = false, priority priority = priority::normal) noexcept
+            : loop_(loop), stealable_(stealable), priority_(priority) {}
 
         doca_pe_run_loop* loop_;
+        // tasks may be stolen by other members of the loop's work stealing group
+        bool stealable_;
+        // class of the loop's queues tasks wait in; ignored for stealable tasks
+        priority priority_;
 
     public:
         using t = scheduler;
@@ -179,7 +635,39 @@ public:
 
         [[nodiscard]]
         auto schedule() const noexcept -> schedule_task {
-            return schedule_task{loop_};
+            return schedule_task{loop_, stealable_, priority_};
+        }
+
+        // Like schedule(), but runs ahead of the class's other tasks in
+        // earliest-deadline-first order. Only orders the queue: a task is
+        // still run after its deadline has passed.
+        [[nodiscard]]
+        auto schedule_before(std::chrono::steady_clock::time_point deadline) const noexcept -> schedule_before_task {
+            return schedule_before_task{loop_, priority_, deadline};
+        }
+
+        [[nodiscard]]
+        auto get_priority() const noexcept -> priority {
+            return priority_;
+        }
+
+        [[nodiscard]]
+        static auto now() noexcept -> std::chrono::steady_clock::time_point {
+            return std::chrono::steady_clock::now();
+        }
+
+        // Completes on the PE thread once the deadline has passed, or with
+        // set_stopped if stop is requested before that. Timers always run
+        // on the PE thread, also for a stealable scheduler.
+        [[nodiscard]]
+        auto schedule_at(std::chrono::steady_clock::time_point deadline) const noexcept -> schedule_at_task {
+            return schedule_at_task{loop_, deadline};
+        }
+
+        template <class Rep, class Period>
+        [[nodiscard]]
+        auto schedule_after(std::chrono::duration<Rep, Period> delay) const noexcept -> schedule_after_task {
+            return schedule_after_task{loop_, std::chrono::ceil<std::chrono::steady_clock::duration>(delay)};
         }
 
         [[nodiscard]]
@@ -192,89 +680,1034 @@ public:
         static auto query(stdexec::execute_may_block_caller_t) noexcept -> bool {
             return false;
         }
+
+        [[nodiscard]]
+        static auto query(stdexec::get_domain_t) noexcept -> domain;
     };
 
-    explicit doca_pe_run_loop(ProgressEngine pe) noexcept : pe(std::move(pe)) {}
+    explicit doca_pe_run_loop(ProgressEngine pe, run_loop_options options = {});
+
+    doca_pe_run_loop(doca_pe_run_loop&&) = delete;
+
+    ~doca_pe_run_loop();
+
+    auto get_scheduler(priority priority = priority::normal) noexcept -> scheduler {
+        return scheduler{this, false, priority};
+    }
+
+    // Work scheduled here may run on another member of the work stealing
+    // group, or on one of its helper threads. Meant for CPU-only
+    // continuations; transition back with get_scheduler() before touching
+    // DOCA objects owned by this PE. Without a group it behaves like
+    // get_scheduler().
+    auto get_stealable_scheduler() noexcept -> scheduler {
+        return scheduler{this, true};
+    }
+
+    // whether the calling thread is the one running this loop
+    [[nodiscard]]
+    bool on_loop_thread() const noexcept {
+        return current_ == this;
+    }
 
-    auto get_scheduler() noexcept -> scheduler {
-        return scheduler{this};
+    // Runs `hook` once when the current pass ends; PE thread only. Deferring
+    // a hook that is already queued does nothing.
+    void defer_to_pass_end(pass_hook& hook) noexcept {
+        if (!hook.queued) {
+            hook.queued = true;
+            hook.next = deferred_;
+            deferred_ = &hook;
+        }
+    }
+
+    // must be called before run() or from the PE thread
+    void join_work_stealing_group(work_stealing_group& group) {
+        group_ = &group;
+        stealable_queue_ = group.join();
     }
 
     auto connect_ctx(std::shared_ptr<Context> ctx) {
+        ctx->connected_loop = this;
         pe.connect_ctx(std::move(ctx));
     }
 
     void run();
 
-    void run_some();
+    /**
+     * @brief Runs the loop on the calling thread until `done()` holds
+     *
+     * For callers that drive the PE themselves instead of leaving it to a
+     * dedicated thread; `done` is checked before every pass and before
+     * blocking in progress_mode::adaptive. Whoever makes it true from
+     * another thread must call wake() afterwards. No other thread may run
+     * the loop meanwhile.
+     */
+    template <typename Done>
+    void run_until(Done done);
+
+    // wakes the thread running the loop if it is blocked waiting for work
+    void wake() noexcept {
+        wake_();
+    }
+
+    // runs up to max_tasks_per_pass pending tasks and the pass hooks they
+    // deferred, returns whether any task was executed
+    bool run_some();
 
     void finish();
 
+    // Driving the loop from an external event loop instead of run():
+    //
+    //   while (loop.poll_once()) {}
+    //   if (loop.arm_notification()) {
+    //       wait until get_notification_fd() is readable or next_timer_deadline() passes
+    //   }
+    //   loop.clear_notification();
+    //
+    // The fd becomes readable on PE completions and on newly scheduled tasks.
+
+    // runs one pass over tasks, completions and timers, returns whether anything happened
+    bool poll_once();
+
+    // When the earliest armed timer may expire, nullopt if none is armed.
+    // PE thread only.
+    [[nodiscard]]
+    std::optional<std::chrono::steady_clock::time_point> next_timer_deadline() const noexcept {
+        return timers_.next_expiry();
+    }
+
+    // returns false if work is already pending and the caller must not block
+    bool arm_notification();
+
+    void clear_notification() noexcept;
+
+    [[nodiscard]]
+    int get_notification_fd() const noexcept {
+        return epoll_fd_;
+    }
+
+    // consistent per counter, callable from any thread; the first call in
+    // a process may wait a few milliseconds to calibrate the cycle clock
+    [[nodiscard]]
+    run_loop_stats stats() const noexcept;
+
 public:
     ProgressEngine pe;
 
 private:
-    void push_back_(task* task);
-    auto pop_front_() -> task*;
+    bool try_run_inline_(task* task, priority priority) noexcept;
+    void push_back_(task* task, priority priority = priority::normal);
+    void push_deadline_(deadline_task* task);
+    void push_stealable_(task* task);
+    void notify_remote_() noexcept;
+    bool run_pass_();
+    bool run_tasks_();
+    void splice_remote_(size_t index);
+    void splice_remote_deadlines_();
+    task* pop_next_(size_t& index) noexcept;
+    bool has_local_work_() const noexcept;
+    bool has_remote_work_() const noexcept;
+    bool poll_completions_();
+    bool run_stealable_(bool idle);
+    bool run_timers_() noexcept;
+    bool timer_due_() const noexcept;
+
+    void run_deferred_() noexcept;
+    template <typename Done>
+    void wait_for_work_(Done& done);
+    void wake_() noexcept;
+
+    // Makes the loop the calling thread's for as long as it lives: inline
+    // scheduling, the counters of its completions and its frame pool.
+    class thread_scope {
+    public:
+        explicit thread_scope(doca_pe_run_loop* loop) noexcept
+            : prev_(std::exchange(current_, loop)),
+              prev_counters_(std::exchange(run_loop_counters::current, &loop->counters_)),
+              prev_frames_(std::exchange(frame_pool::current, &loop->frames_)) {}
+
+        thread_scope(const thread_scope&) = delete;
+        thread_scope& operator=(const thread_scope&) = delete;
+
+        ~thread_scope() {
+            frame_pool::current = prev_frames_;
+            run_loop_counters::current = prev_counters_;
+            current_ = prev_;
+        }
 
-    std::mutex mutex_;
-    std::condition_variable cv_;
-    task head{{}, &head, {&head}};
-    bool stop_ = false;
+    private:
+        doca_pe_run_loop* prev_;
+        run_loop_counters* prev_counters_;
+        frame_pool* prev_frames_;
+    };
+
+    // the loop currently being run by this thread, if any
+    static inline thread_local doca_pe_run_loop* current_ = nullptr;
+    // nesting of inline schedule() completions on this thread
+    static inline thread_local unsigned inline_depth_ = 0;
+
+    // tasks scheduled from other threads, one queue per priority class
+    std::array<mpsc_queue<task>, priority_count> remote_queues_;
+    // deadline tasks of any class scheduled from other threads
+    mpsc_queue<task> remote_deadline_queue_;
+    // tasks scheduled from the PE thread itself plus the batches taken from
+    // the remote queues, touched by that thread only
+    std::array<class_queue, priority_count> local_queues_;
+    // tasks left in the current round of priority_policy::weighted
+    std::array<unsigned, priority_count> credits_{};
+    std::atomic<bool> stop_ = false;
+
+    work_stealing_group* group_ = nullptr;
+    // this loop's deque in group_, pushed and popped by the PE thread only
+    work_stealing_group::deque_type* stealable_queue_ = nullptr;
+
+    // armed by schedule_at/schedule_after, touched by the PE thread only
+    timer_wheel timers_;
+    // pass hooks to run when the current pass ends, PE thread only
+    pass_hook* deferred_ = nullptr;
+
+    run_loop_options options_;
+    // set while the consumer is blocked (or about to block) on epoll_fd_
+    alignas(cache_line_size) std::atomic<bool> sleeping_ = false;
+    int wakeup_fd_ = -1;
+    int epoll_fd_ = -1;
+
+    // written by the PE thread only, read by stats()
+    run_loop_counters counters_;
+    // coroutine frames and operation states allocated on the PE thread
+    frame_pool frames_;
 };
 
 template <class ReceiverId>
 inline void operation<ReceiverId>::t::start() & noexcept {
+    if (!stealable_ && loop_->try_run_inline_(this, priority_)) {
+        return;
+    }
+
     try {
-        loop_->push_back_(this);
+        if (stealable_) {
+            loop_->push_stealable_(this);
+        } else {
+            loop_->push_back_(this, priority_);
+        }
+    } catch (...) {
+        stdexec::set_error(static_cast<Receiver&&>(rcvr_), std::current_exception());
+    }
+}
+
+template <class ReceiverId>
+inline void deadline_operation<ReceiverId>::t::start() & noexcept {
+    // never inline, the point is to be ordered against the queued tasks
+    try {
+        loop_->push_deadline_(this);
     } catch (...) {
         stdexec::set_error(static_cast<Receiver&&>(rcvr_), std::current_exception());
     }
 }
 
+template <class ReceiverId>
+inline void timer_operation<ReceiverId>::t::start() & noexcept {
+    if (delay_) {
+        deadline_ = std::chrono::steady_clock::now() + *delay_;
+    }
+    // the wheel is only touched on the PE thread, hop there first
+    loop_->push_back_(this);
+}
+
+template <class ReceiverId>
+inline void timer_operation<ReceiverId>::t::on_stop::operator()() const noexcept {
+    self_->cancel_requested_.store(true, std::memory_order_release);
+    self_->loop_->push_back_(&self_->cancel_);
+}
+
+template <class ReceiverId>
+inline void timer_operation<ReceiverId>::t::arm_impl(task* p) noexcept {
+    auto* self = static_cast<t*>(p);
+    self->timer_node::deadline = timer_wheel::to_ticks_ceil(self->deadline_);
+
+    if constexpr (stdexec::unstoppable_token<stop_token_t>) {
+        self->loop_->timers_.insert(self);
+    } else {
+        auto token = stdexec::get_stop_token(stdexec::get_env(self->rcvr_));
+        if (token.stop_requested()) {
+            stdexec::set_stopped(static_cast<Receiver&&>(self->rcvr_));
+            return;
+        }
+        self->loop_->timers_.insert(self);
+        // a stop request racing with this only queues cancel_
+        self->on_stop_.emplace(token, on_stop{self});
+    }
+}
+
+template <class ReceiverId>
+inline void timer_operation<ReceiverId>::t::fire_impl(timer_node* node) noexcept {
+    auto* self = static_cast<t*>(node);
+    if constexpr (!stdexec::unstoppable_token<stop_token_t>) {
+        // waits for a concurrently running on_stop; if it ran, cancel_ is
+        // queued and completes the operation
+        self->on_stop_.reset();
+        if (self->cancel_requested_.load(std::memory_order_acquire)) {
+            return;
+        }
+    }
+    stdexec::set_value(static_cast<Receiver&&>(self->rcvr_));
+}
+
+template <class ReceiverId>
+inline void timer_operation<ReceiverId>::t::cancel_impl(task* p) noexcept {
+    auto* self = static_cast<cancel_task*>(p)->self_;
+    self->loop_->timers_.remove(self);
+    self->on_stop_.reset();
+    stdexec::set_stopped(static_cast<Receiver&&>(self->rcvr_));
+}
+
+inline doca_pe_run_loop::doca_pe_run_loop(ProgressEngine pe, run_loop_options options)
+    : pe(std::move(pe)), options_(options) {
+    auto fail = [this](const char* what) {
+        auto error = errno;
+        if (epoll_fd_ >= 0) {
+            close(epoll_fd_);
+        }
+        if (wakeup_fd_ >= 0) {
+            close(wakeup_fd_);
+        }
+        throw std::system_error(error, std::system_category(), what);
+    };
+
+    wakeup_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (wakeup_fd_ < 0) {
+        fail("Failed to create wakeup eventfd");
+    }
+
+    epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+    if (epoll_fd_ < 0) {
+        fail("Failed to create epoll fd");
+    }
+
+    epoll_event event{.events = EPOLLIN, .data = {.fd = wakeup_fd_}};
+    if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, wakeup_fd_, &event) < 0) {
+        fail("Failed to add wakeup eventfd to epoll");
+    }
+
+    auto handle = this->pe.get_notification_handle();
+    event = epoll_event{.events = EPOLLIN, .data = {.fd = handle}};
+    if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, handle, &event) < 0) {
+        fail("Failed to add pe notification handle to epoll");
+    }
+}
+
+inline doca_pe_run_loop::~doca_pe_run_loop() {
+    close(epoll_fd_);
+    close(wakeup_fd_);
+}
+
 inline void doca_pe_run_loop::run() {
-    while (!stop_) {
-        run_some();
-        while (pe.progress()) {
+    run_until([this] { return stop_.load(std::memory_order_acquire); });
+}
+
+template <typename Done>
+void doca_pe_run_loop::run_until(Done done) {
+    thread_scope scope{this};
+    auto last_work = std::chrono::steady_clock::now();
+
+    while (!done()) {
+        bool worked = run_pass_();
+
+        if (options_.mode == progress_mode::spin) {
+            continue;
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        if (worked) {
+            last_work = now;
+        } else if (now - last_work >= options_.spin_window) {
+            wait_for_work_(done);
+            last_work = std::chrono::steady_clock::now();
         }
     }
 }
 
-inline void doca_pe_run_loop::run_some() {
-    for (task* task; (task = pop_front_()) != &head;) {
-        printf("Executing task\n");
+namespace detail {
+
+// Tracks the time slice of one phase. The clock is read every 16 steps
+// only, and not at all when no slice is configured.
+class phase_slice {
+public:
+    explicit phase_slice(std::chrono::nanoseconds slice) noexcept
+        : enabled_(slice.count() > 0),
+          deadline_(enabled_ ? std::chrono::steady_clock::now() + slice : std::chrono::steady_clock::time_point{}) {}
+
+    bool expired(size_t steps) const noexcept {
+        return enabled_ && steps % 16 == 0 && std::chrono::steady_clock::now() >= deadline_;
+    }
+
+private:
+    bool enabled_;
+    std::chrono::steady_clock::time_point deadline_;
+};
+
+inline size_t budget_or_unbounded(size_t budget) noexcept {
+    return budget == 0 ? SIZE_MAX : budget;
+}
+
+} // namespace detail
+
+inline bool doca_pe_run_loop::run_pass_() {
+    counters_.passes.add(1);
+    auto begin = cycle_clock::now();
+    bool worked = run_tasks_();
+
+    // completions run receivers from inside progress(); their time is
+    // accounted by completion_scope and taken out of the polling time
+    auto poll_begin = cycle_clock::now();
+    auto receiver_before = counters_.receiver_ticks.load();
+    worked |= poll_completions_();
+    auto poll_end = cycle_clock::now();
+    auto receiver_ticks = counters_.receiver_ticks.load() - receiver_before;
+
+    worked |= run_stealable_(!worked);
+    worked |= run_timers_();
+    run_deferred_();
+    auto end = cycle_clock::now();
+
+    counters_.task_ticks.add((poll_begin - begin) + (end - poll_end));
+    auto poll_ticks = poll_end - poll_begin;
+    counters_.poll_ticks.add(poll_ticks > receiver_ticks ? poll_ticks - receiver_ticks : 0);
+    return worked;
+}
+
+inline bool doca_pe_run_loop::run_some() {
+    bool worked = run_tasks_();
+    run_deferred_();
+    return worked;
+}
+
+inline void doca_pe_run_loop::run_deferred_() noexcept {
+    // hooks deferred while these run wait for the end of the next pass
+    auto* hook = std::exchange(deferred_, nullptr);
+    while (hook != nullptr) {
+        auto* next = hook->next;
+        hook->queued = false;
+        hook->run(hook);
+        hook = next;
+    }
+}
+
+inline bool doca_pe_run_loop::run_tasks_() {
+    // one exchange per queue takes everything other threads scheduled so
+    // far; apart from high priority ones, remote tasks scheduled while this
+    // phase runs wait for the next pass
+    for (size_t index = 0; index < priority_count; index++) {
+        splice_remote_(index);
+    }
+    splice_remote_deadlines_();
+
+    auto budget = detail::budget_or_unbounded(options_.max_tasks_per_pass);
+    detail::phase_slice slice{options_.time_slice};
+    size_t executed = 0;
+    std::array<uint64_t, priority_count> executed_by_priority{};
+    while (executed < budget) {
+        size_t index = 0;
+        auto* task = pop_next_(index);
+        if (task == nullptr) {
+            break;
+        }
+        counters_.local_queue_depth--;
+        DOCA_STDEXEC_TRACE_EVENT(task_run_begin, task, index);
         task->execute();
-        printf("Executed task\n");
+        DOCA_STDEXEC_TRACE_EVENT(task_run_end, task);
+        executed++;
+        executed_by_priority[index]++;
+        if (slice.expired(executed)) {
+            if (has_local_work_()) {
+                counters_.task_slice_exhausted.add(1);
+            }
+            break;
+        }
+    }
+    if (executed == budget && has_local_work_()) {
+        counters_.task_budget_exhausted.add(1);
+    }
+
+    counters_.tasks_executed.add(executed);
+    for (size_t index = 0; index < priority_count; index++) {
+        if (executed_by_priority[index] > 0) {
+            counters_.tasks_by_priority[index].add(executed_by_priority[index]);
+        }
+    }
+    return executed > 0;
+}
+
+inline void doca_pe_run_loop::splice_remote_(size_t index) {
+    if (auto taken = remote_queues_[index].take_all(local_queues_[index].fifo())) {
+        DOCA_STDEXEC_TRACE_EVENT(queue_splice, this, taken);
+        counters_.remote_batches.add(1);
+        counters_.remote_tasks.add(taken);
+        counters_.remote_batch_high_water.raise_to(taken);
+        counters_.local_queue_depth += taken;
+        counters_.local_queue_high_water.raise_to(counters_.local_queue_depth);
+    }
+}
+
+inline void doca_pe_run_loop::splice_remote_deadlines_() {
+    intrusive_queue<task> batch;
+    if (auto taken = remote_deadline_queue_.take_all(batch)) {
+        DOCA_STDEXEC_TRACE_EVENT(queue_splice, this, taken);
+        counters_.remote_batches.add(1);
+        counters_.remote_tasks.add(taken);
+        counters_.remote_batch_high_water.raise_to(taken);
+        counters_.local_queue_depth += taken;
+        counters_.local_queue_high_water.raise_to(counters_.local_queue_depth);
+        while (auto* task = static_cast<deadline_task*>(batch.pop())) {
+            local_queues_[index_of(task->priority_)].push(task);
+        }
+    }
+}
+
+inline task* doca_pe_run_loop::pop_next_(size_t& index) noexcept {
+    // a high priority task scheduled from another thread does not wait
+    // for the next pass; costs one load of a line producers rarely write
+    constexpr auto high = index_of(priority::high);
+    if (local_queues_[high].empty() && !remote_queues_[high].empty()) {
+        splice_remote_(high);
     }
+
+    if (options_.dequeue_policy == priority_policy::strict) {
+        for (index = 0; index < priority_count; index++) {
+            if (!local_queues_[index].empty()) {
+                return local_queues_[index].pop();
+            }
+        }
+        return nullptr;
+    }
+
+    for (int round = 0; round < 2; round++) {
+        for (index = 0; index < priority_count; index++) {
+            if (credits_[index] > 0 && !local_queues_[index].empty()) {
+                credits_[index]--;
+                return local_queues_[index].pop();
+            }
+        }
+        // every class with work has used up its share of this round
+        for (size_t i = 0; i < priority_count; i++) {
+            credits_[i] = std::max(1U, options_.priority_weights[i]);
+        }
+    }
+    return nullptr;
+}
+
+inline bool doca_pe_run_loop::has_local_work_() const noexcept {
+    return std::ranges::any_of(local_queues_, [](const class_queue& queue) { return !queue.empty(); });
+}
+
+inline bool doca_pe_run_loop::has_remote_work_() const noexcept {
+    return !remote_deadline_queue_.empty() ||
+           std::ranges::any_of(remote_queues_, [](const mpsc_queue<task>& queue) { return !queue.empty(); });
+}
+
+inline bool doca_pe_run_loop::poll_completions_() {
+    auto budget = detail::budget_or_unbounded(options_.max_completions_per_pass);
+    detail::phase_slice slice{options_.time_slice};
+    size_t productive = 0;
+    while (productive < budget) {
+        if (!pe.progress()) {
+            counters_.empty_polls.add(1);
+            break;
+        }
+        productive++;
+        if (slice.expired(productive)) {
+            counters_.completion_slice_exhausted.add(1);
+            break;
+        }
+    }
+    if (productive == budget) {
+        counters_.completion_budget_exhausted.add(1);
+    }
+
+    counters_.productive_polls.add(productive);
+    return productive > 0;
+}
+
+inline run_loop_stats doca_pe_run_loop::stats() const noexcept {
+    auto ticks_per_ns = cycle_clock::ticks_per_ns();
+    auto to_ns = [ticks_per_ns](uint64_t ticks) {
+        return std::chrono::nanoseconds(cycle_clock::to_ns(ticks, ticks_per_ns));
+    };
+    // read separately while the PE thread updates them, so they may be slightly apart
+    auto completed = counters_.doca_tasks_completed.load();
+    auto submitted = counters_.doca_tasks_submitted.load();
+    return run_loop_stats{
+        .passes = counters_.passes.load(),
+        .tasks_inlined = counters_.tasks_inlined.load(),
+        .tasks_executed = counters_.tasks_executed.load(),
+        .remote_batches = counters_.remote_batches.load(),
+        .remote_tasks = counters_.remote_tasks.load(),
+        .task_budget_exhausted = counters_.task_budget_exhausted.load(),
+        .task_slice_exhausted = counters_.task_slice_exhausted.load(),
+        .productive_polls = counters_.productive_polls.load(),
+        .empty_polls = counters_.empty_polls.load(),
+        .completion_budget_exhausted = counters_.completion_budget_exhausted.load(),
+        .completion_slice_exhausted = counters_.completion_slice_exhausted.load(),
+        .timers_fired = counters_.timers_fired.load(),
+        .tasks_by_priority = {counters_.tasks_by_priority[0].load(), counters_.tasks_by_priority[1].load(),
+                              counters_.tasks_by_priority[2].load()},
+        .local_queue_high_water = counters_.local_queue_high_water.load(),
+        .remote_batch_high_water = counters_.remote_batch_high_water.load(),
+        .doca_tasks_submitted = submitted,
+        .doca_tasks_completed = completed,
+        .doca_tasks_in_flight = submitted > completed ? submitted - completed : 0,
+        .doca_tasks_in_flight_high_water = counters_.doca_tasks_in_flight_high_water.load(),
+        .task_time = to_ns(counters_.task_ticks.load()),
+        .receiver_time = to_ns(counters_.receiver_ticks.load()),
+        .poll_time = to_ns(counters_.poll_ticks.load()),
+        .sleep_time = to_ns(counters_.sleep_ticks.load()),
+        .frames_allocated = frames_.heap_allocations(),
+        .frames_recycled = frames_.recycled(),
+    };
 }
 
 inline void doca_pe_run_loop::finish() {
-    stop_ = true;
+    stop_.store(true, std::memory_order_seq_cst);
+    wake_();
 }
 
-inline void doca_pe_run_loop::push_back_(task* task) {
-    std::unique_lock lock(mutex_);
-    task->next = &head;
-    head.tail = head.tail->next = task;
+inline bool doca_pe_run_loop::poll_once() {
+    thread_scope scope{this};
+    return run_pass_();
 }
 
-inline auto doca_pe_run_loop::pop_front_() -> task* {
-    std::unique_lock lock(mutex_);
-    if (head.tail == head.next)
-        head.tail = &head;
-    return std::exchange(head.next, head.next->next);
+inline bool doca_pe_run_loop::arm_notification() {
+    // the last poll below may deliver completions, which run as in a pass
+    thread_scope scope{this};
+
+    // Publish sleeping_ before looking at the queue; pairs with the fence in
+    // notify_remote_ so either we see the task or the producer sees us sleeping.
+    sleeping_.store(true, std::memory_order_seq_cst);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    pe.request_notification();
+
+    // Completions that landed before the notification was armed do not fire
+    // the handle, so poll once more before committing to sleep.
+    bool has_stealable = stealable_queue_ != nullptr && !stealable_queue_->empty();
+    if (has_local_work_() || has_remote_work_() || has_stealable || deferred_ != nullptr ||
+        stop_.load(std::memory_order_seq_cst) ||
+        timer_due_() || pe.progress()) {
+        sleeping_.store(false, std::memory_order_relaxed);
+        return false;
+    }
+    return true;
+}
+
+inline void doca_pe_run_loop::clear_notification() noexcept {
+    sleeping_.store(false, std::memory_order_relaxed);
+
+    uint64_t count;
+    while (read(wakeup_fd_, &count, sizeof(count)) > 0) {
+    }
+
+    pe.clear_notification();
+}
+
+template <typename Done>
+void doca_pe_run_loop::wait_for_work_(Done& done) {
+    // Wake up a spin window ahead of the next timer and spin into it, so
+    // timers are not delayed by the wakeup latency.
+    std::optional<timespec> timeout;
+    if (auto next = timers_.next_expiry()) {
+        auto wait = *next - std::chrono::steady_clock::now() - options_.spin_window;
+        if (wait <= std::chrono::steady_clock::duration::zero()) {
+            return;
+        }
+        auto seconds = std::chrono::floor<std::chrono::seconds>(wait);
+        timeout = timespec{.tv_sec = static_cast<time_t>(seconds.count()),
+                           .tv_nsec = static_cast<long>(std::chrono::nanoseconds(wait - seconds).count())};
+    }
+
+    if (!arm_notification()) {
+        return;
+    }
+    // pairs with wake() after done() was made true on another thread
+    if (done()) {
+        clear_notification();
+        return;
+    }
+
+    auto begin = cycle_clock::now();
+    epoll_event events[2];
+    while (epoll_pwait2(epoll_fd_, events, 2, timeout ? &*timeout : nullptr, nullptr) < 0 && errno == EINTR) {
+    }
+    counters_.sleep_ticks.add(cycle_clock::now() - begin);
+
+    clear_notification();
+}
+
+inline void doca_pe_run_loop::wake_() noexcept {
+    // only the producer that flips the flag pays for the syscall
+    if (sleeping_.exchange(false, std::memory_order_seq_cst)) {
+        uint64_t one = 1;
+        [[maybe_unused]] auto written = write(wakeup_fd_, &one, sizeof(one));
+    }
+}
+
+// Trampoline for same-thread scheduling: a schedule() started on the PE
+// thread runs its receiver right away instead of taking a queue round trip.
+// The depth bound keeps long synchronous chains from growing the stack
+// without limit and from monopolizing the pass.
+inline bool doca_pe_run_loop::try_run_inline_(task* task, priority priority) noexcept {
+    if (current_ != this || inline_depth_ >= options_.max_inline_depth) {
+        return false;
+    }
+    // never overtake queued work of a higher class
+    for (size_t index = 0; index < index_of(priority); index++) {
+        if (!local_queues_[index].empty()) {
+            return false;
+        }
+    }
+
+    inline_depth_++;
+    counters_.tasks_inlined.add(1);
+    DOCA_STDEXEC_TRACE_EVENT(task_run_begin, task, 1);
+    task->execute();
+    DOCA_STDEXEC_TRACE_EVENT(task_run_end, task);
+    inline_depth_--;
+    return true;
+}
+
+inline void doca_pe_run_loop::push_back_(task* task, priority priority) {
+    if (current_ == this) {
+        DOCA_STDEXEC_TRACE_EVENT(queue_push, task, 0);
+        local_queues_[index_of(priority)].push(task);
+        counters_.local_queue_high_water.raise_to(++counters_.local_queue_depth);
+        return;
+    }
+
+    DOCA_STDEXEC_TRACE_EVENT(queue_push, task, 1);
+    remote_queues_[index_of(priority)].push(task);
+    notify_remote_();
+}
+
+inline void doca_pe_run_loop::push_deadline_(deadline_task* task) {
+    if (current_ == this) {
+        DOCA_STDEXEC_TRACE_EVENT(queue_push, task, 0);
+        local_queues_[index_of(task->priority_)].push(task);
+        counters_.local_queue_high_water.raise_to(++counters_.local_queue_depth);
+        return;
+    }
+
+    DOCA_STDEXEC_TRACE_EVENT(queue_push, task, 1);
+    remote_deadline_queue_.push(task);
+    notify_remote_();
+}
+
+inline void doca_pe_run_loop::notify_remote_() noexcept {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (sleeping_.load(std::memory_order_relaxed)) {
+        wake_();
+    }
+}
+
+inline void doca_pe_run_loop::push_stealable_(task* task) {
+    // only the owner may push onto the deque
+    if (stealable_queue_ != nullptr && current_ == this) {
+        DOCA_STDEXEC_TRACE_EVENT(queue_push, task, 2);
+        stealable_queue_->push(task);
+    } else {
+        push_back_(task);
+    }
+}
+
+inline bool doca_pe_run_loop::run_stealable_(bool idle) {
+    if (stealable_queue_ == nullptr) {
+        return false;
+    }
+
+    // one task per pass so completions keep being polled between them
+    auto* task = stealable_queue_->pop();
+    if (task == nullptr && idle) {
+        task = group_->steal(stealable_queue_);
+    }
+    if (task == nullptr) {
+        return false;
+    }
+
+    DOCA_STDEXEC_TRACE_EVENT(task_run_begin, task, 2);
+    task->execute();
+    DOCA_STDEXEC_TRACE_EVENT(task_run_end, task);
+    return true;
+}
+
+inline bool doca_pe_run_loop::run_timers_() noexcept {
+    if (timers_.empty()) {
+        return false;
+    }
+    auto fired = timers_.advance(std::chrono::steady_clock::now());
+    counters_.timers_fired.add(fired);
+    return fired > 0;
+}
+
+inline bool doca_pe_run_loop::timer_due_() const noexcept {
+    auto next = timers_.next_expiry();
+    return next && *next <= std::chrono::steady_clock::now();
+}
+
+/**
+ * @brief Environment of a sender whose values arrive on a loop's thread
+ *
+ * RDMA senders report the scheduler of the loop their context is connected
+ * to, so that algorithms know their completions already run on the PE
+ * thread. A sender that may complete inside start(), like connecting an
+ * exported connection, must then be started on that thread, which DOCA
+ * requires of everything touching the context anyway.
+ */
+struct completion_env {
+    doca_pe_run_loop::scheduler scheduler;
+
+    [[nodiscard]]
+    auto query(stdexec::get_completion_scheduler_t<stdexec::set_value_t>) const noexcept
+        -> doca_pe_run_loop::scheduler {
+        return scheduler;
+    }
+};
+
+namespace detail {
+
+template <class Sender>
+concept completes_on_loop = requires(const Sender& sndr) {
+    {
+        stdexec::get_completion_scheduler<stdexec::set_value_t>(stdexec::get_env(sndr))
+    } -> std::same_as<doca_pe_run_loop::scheduler>;
+};
+
+// the scheduler continues_on transitions to, from the data it stores
+template <class Data>
+auto continues_on_target(const Data& data) {
+    if constexpr (requires { stdexec::get_completion_scheduler<stdexec::set_value_t>(data); }) {
+        return stdexec::get_completion_scheduler<stdexec::set_value_t>(data);
+    } else {
+        return data;
+    }
+}
+
+template <class Sender>
+concept same_loop_continues_on_candidate =
+    stdexec::sender_expr_for<Sender, stdexec::continues_on_t> &&
+    completes_on_loop<stdexec::__child_of<Sender>> &&
+    std::same_as<decltype(continues_on_target(std::declval<const stdexec::__data_of<Sender>&>())),
+                 doca_pe_run_loop::scheduler>;
+
+/**
+ * @brief continues_on(child, target) for a child completing on a run loop
+ *
+ * Both schedulers are only known at run time. A child that already
+ * completes on `target` is connected to the receiver directly; any other
+ * goes through schedule_from, as continues_on would.
+ */
+template <class Child>
+struct same_loop_continues_on {
+    using sender_concept = stdexec::sender_t;
+    using scheduler = doca_pe_run_loop::scheduler;
+    using hop_sender = decltype(stdexec::schedule_from(std::declval<scheduler>(), std::declval<Child>()));
+
+    template <class Receiver>
+    struct operation : immovable {
+        using direct_op = stdexec::connect_result_t<Child, Receiver>;
+        using hop_op = stdexec::connect_result_t<hop_sender, Receiver>;
+
+        operation(Child&& child, scheduler target, Receiver&& rcvr) {
+            auto source = stdexec::get_completion_scheduler<stdexec::set_value_t>(stdexec::get_env(child));
+            if (source == target) {
+                auto connect = [&] {
+                    return stdexec::connect(static_cast<Child&&>(child), static_cast<Receiver&&>(rcvr));
+                };
+                op_.template emplace<1>(emplace_from<direct_op, decltype(connect)>{connect});
+            } else {
+                auto connect = [&] {
+                    return stdexec::connect(stdexec::schedule_from(target, static_cast<Child&&>(child)),
+                                            static_cast<Receiver&&>(rcvr));
+                };
+                op_.template emplace<2>(emplace_from<hop_op, decltype(connect)>{connect});
+            }
+        }
+
+        void start() & noexcept {
+            if (auto* direct = std::get_if<1>(&op_)) {
+                stdexec::start(*direct);
+            } else {
+                stdexec::start(std::get<2>(op_));
+            }
+        }
+
+    private:
+        std::variant<std::monostate, direct_op, hop_op> op_;
+    };
+
+    template <class... Env>
+    friend auto get_completion_signatures(const same_loop_continues_on&, Env&&...)
+        -> stdexec::completion_signatures_of_t<hop_sender, Env...> {
+        return {};
+    }
+
+    template <class Receiver>
+    auto connect(Receiver rcvr) && -> operation<Receiver> {
+        return {static_cast<Child&&>(child), target, static_cast<Receiver&&>(rcvr)};
+    }
+
+    [[nodiscard]]
+    auto get_env() const noexcept -> completion_env {
+        return {target};
+    }
+
+    Child child;
+    scheduler target;
+};
+
+// when_all whose children all submit through doorbells
+template <class Sender>
+concept batchable_when_all =
+    stdexec::sender_expr_for<Sender, stdexec::when_all_t> &&
+    decltype(stdexec::__sexpr_apply(std::declval<Sender>(),
+                                    []<class... Children>(stdexec::__ignore, stdexec::__ignore, Children&&...) {
+                                        return std::bool_constant<(doorbell_sender<Children> && ...)>{};
+                                    }))::value;
+
+} // namespace detail
+
+/**
+ * @brief Domain of the run loop's schedulers
+ *
+ * Removes continues_on hops onto the loop a sender already completes on.
+ * `connection.write(src, dst) | continues_on(sched) | then(f)`, with sched
+ * the scheduler of the connection's loop, runs f right in the write's
+ * completion instead of queuing a task that would run on the same thread
+ * later in the pass.
+ *
+ * when_all of RDMA senders alone becomes batch(), so that its tasks share a
+ * doorbell instead of each ringing its own.
+ *
+ * Any other continues_on and when_all, and every other algorithm, is left
+ * to the default domain.
+ */
+struct domain {
+    template <stdexec::sender_expr_for<stdexec::continues_on_t> Sender, class... Env>
+    auto transform_sender(Sender&& sndr, const Env&... env) const {
+        if constexpr (detail::same_loop_continues_on_candidate<Sender>) {
+            return stdexec::__sexpr_apply(static_cast<Sender&&>(sndr),
+                                          []<class Data, class Child>(stdexec::__ignore, Data&& data, Child&& child) {
+                                              return detail::same_loop_continues_on<std::decay_t<Child>>{
+                                                  static_cast<Child&&>(child), detail::continues_on_target(data)};
+                                          });
+        } else {
+            return stdexec::default_domain{}.transform_sender(static_cast<Sender&&>(sndr), env...);
+        }
+    }
+
+    template <stdexec::sender_expr_for<stdexec::when_all_t> Sender, class... Env>
+    auto transform_sender(Sender&& sndr, const Env&... env) const {
+        if constexpr (detail::batchable_when_all<Sender>) {
+            return stdexec::__sexpr_apply(static_cast<Sender&&>(sndr),
+                                          []<class... Children>(stdexec::__ignore, stdexec::__ignore,
+                                                                Children&&... children) {
+                                              return batch(static_cast<Children&&>(children)...);
+                                          });
+        } else {
+            return stdexec::default_domain{}.transform_sender(static_cast<Sender&&>(sndr), env...);
+        }
+    }
+};
+
+inline auto doca_pe_run_loop::scheduler::query(stdexec::get_domain_t) noexcept -> domain {
+    return {};
 }
 
 } // namespace loop
 
 using run_loop = loop::doca_pe_run_loop;
+using work_stealing_group = loop::work_stealing_group;
+
+struct pe_thread_options {
+    // CPU the PE thread is pinned to, -1 leaves it unpinned
+    int cpu = -1;
+    // NUMA node preferred for memory allocated by the PE thread, -1 keeps the default policy
+    int numa_node = -1;
+    // SCHED_FIFO priority, 0 keeps the default scheduling policy
+    int realtime_priority = 0;
+
+    /**
+     * @brief Place the thread on the index-th CPU local to the device's NIC,
+     *        isolated CPUs first, with memory preferred on the NIC's node
+     */
+    static pe_thread_options near(const Device& device, size_t index = 0, int realtime_priority = 0) {
+        pe_thread_options options{.numa_node = device.numa_node(), .realtime_priority = realtime_priority};
+        auto cpus = topology::prefer_isolated(device.local_cpus());
+        if (!cpus.empty()) {
+            options.cpu = cpus[index % cpus.size()];
+        }
+        return options;
+    }
+};
+
+inline void apply_thread_options(const pe_thread_options& options) {
+    if (options.cpu >= 0) {
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        CPU_SET(options.cpu, &cpus);
+        auto err = pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+        if (err != 0) {
+            throw std::system_error(err, std::system_category(), "Failed to pin pe thread");
+        }
+    }
+
+    topology::set_thread_memory_node(options.numa_node);
+
+    if (options.realtime_priority > 0) {
+        sched_param param{.sched_priority = options.realtime_priority};
+        auto err = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+        if (err != 0) {
+            throw std::system_error(err, std::system_category(), "Failed to set pe thread realtime priority");
+        }
+    }
+}
+
+// From the entry of the thread the options are for: reports the outcome to
+// the thread starting it, which rethrows a failure; false if they failed
+inline bool apply_thread_options(const pe_thread_options& options, std::promise<void>& applied) noexcept {
+    try {
+        apply_thread_options(options);
+    } catch (...) {
+        applied.set_exception(std::current_exception());
+        return false;
+    }
+    applied.set_value();
+    return true;
+}
 
 class doca_pe_context {
     run_loop loop_;
     std::thread thread_;
 
 public:
-    explicit doca_pe_context(ProgressEngine pe) noexcept : loop_(std::move(pe)), thread_([this]() { loop_.run(); }) {}
+    explicit doca_pe_context(ProgressEngine pe, loop::run_loop_options options = {},
+                             pe_thread_options thread_options = {})
+        : loop_(std::move(pe), options) {
+        std::promise<void> ready;
+        auto applied = ready.get_future();
+        thread_ = std::thread([this, thread_options, ready = std::move(ready)]() mutable {
+            trace::set_thread_name("pe");
+            if (apply_thread_options(thread_options, ready)) {
+                loop_.run();
+            }
+        });
+        // options that cannot be applied fail the constructor, not the thread
+        try {
+            applied.get();
+        } catch (...) {
+            thread_.join();
+            throw;
+        }
+    }
+
+    explicit doca_pe_context(loop::run_loop_options options) : doca_pe_context(ProgressEngine{}, options) {}
 
     doca_pe_context() : doca_pe_context(ProgressEngine{}) {}
 
@@ -282,14 +1715,32 @@ public:
         return loop_.pe;
     }
 
-    auto get_scheduler() noexcept {
-        return loop_.get_scheduler();
+    auto& get_loop() noexcept {
+        return loop_;
+    }
+
+    auto get_scheduler(priority priority = priority::normal) noexcept {
+        return loop_.get_scheduler(priority);
+    }
+
+    auto get_stealable_scheduler() noexcept {
+        return loop_.get_stealable_scheduler();
     }
 
     auto connect_ctx(std::shared_ptr<Context> ctx) {
         return loop_.connect_ctx(std::move(ctx));
     }
 
+    [[nodiscard]]
+    auto stats() const noexcept {
+        return loop_.stats();
+    }
+
+    void join_work_stealing_group(loop::work_stealing_group& group) {
+        stdexec::sync_wait(stdexec::schedule(loop_.get_scheduler()) |
+                           stdexec::then([&] { loop_.join_work_stealing_group(group); }));
+    }
+
     void join() {
         thread_.join();
     }
@@ -1,7 +1,7 @@
 #pragma once
 #include "doca_stdexec/common/tcp.hpp"
+#include <algorithm>
 #include <cstdint>
-#include <cstdio>
 #include <utility>
 #ifndef DOCA_STDEXEC_RDMA_HPP
 #define DOCA_STDEXEC_RDMA_HPP
@@ -13,7 +13,11 @@
 
 #include "buf.hpp"
 #include "doca_stdexec/device.hpp"
+#include "doca_stdexec/doorbell.hpp"
 #include "doca_stdexec/operation.hpp"
+#include "doca_stdexec/rdma/latency.hpp"
+#include "doca_stdexec/trace.hpp"
+#include "rdma/bulk.hpp"
 #include "rdma/task.hpp"
 #include <doca_error.h>
 #include <doca_rdma.h>
@@ -23,7 +27,6 @@ namespace doca_stdexec::rdma {
 
 struct doca_rdma_deleter {
     void operator()(doca_rdma* rdma) {
-        printf("Destroying rdma\n");
         doca_rdma_destroy(rdma);
     }
 };
@@ -39,6 +42,13 @@ struct Rdma : public std::enable_shared_from_this<Rdma>, public Context {
 
     std::unique_ptr<doca_rdma, doca_rdma_deleter> rdma;
     std::shared_ptr<Device> dev;
+    // all connections of this context
+    latency::histograms latency_histograms;
+    // initialized tasks of finished operations, reused by the next ones;
+    // declared after `rdma` so that they are freed before it is destroyed
+    task::task_cache tasks;
+    // every task of the context is submitted through it, see batch()
+    doorbell bell;
 
     doca_rdma* get() const noexcept {
         return rdma.get();
@@ -57,27 +67,106 @@ struct Rdma : public std::enable_shared_from_this<Rdma>, public Context {
         return std::make_shared<Rdma>(rdma, std::move(dev));
     }
 
+    // upper bound of the default task pool size per opcode
+    static constexpr uint32_t max_default_task_pool_size = 1024;
+
+    /**
+     * @brief Sizes the task pools to the queues of the device
+     *
+     * Writes, reads and sends each get as many tasks as the send queue can
+     * hold, receives as many as the receive queue, capped at
+     * max_default_task_pool_size. Operations beyond that wait for a task
+     * instead of failing.
+     */
     void set_conf() {
-        set_write_conf(16);
-        set_read_conf(16);
-        set_send_conf(16);
+        auto* devinfo = doca_dev_as_devinfo(dev->get());
+        auto pool_size = [](auto get_cap, const doca_devinfo* devinfo) {
+            uint32_t queue_size = 0;
+            if (get_cap(devinfo, &queue_size) != DOCA_SUCCESS || queue_size == 0) {
+                return uint32_t{16};
+            }
+            return std::min(queue_size, max_default_task_pool_size);
+        };
+        auto send_tasks = pool_size(doca_rdma_cap_get_max_send_queue_size, devinfo);
+        auto recv_tasks = pool_size(doca_rdma_cap_get_max_recv_queue_size, devinfo);
+        set_write_conf(send_tasks);
+        set_read_conf(send_tasks);
+        set_send_conf(send_tasks);
+        set_recv_conf(recv_tasks);
+        set_imm_conf(send_tasks);
+    }
+
+    // Tasks per opcode instead of the device-derived default; before start()
+    void set_task_pool_size(uint32_t num_tasks) {
+        set_write_conf(num_tasks);
+        set_read_conf(num_tasks);
+        set_send_conf(num_tasks);
+        set_recv_conf(num_tasks);
+        set_imm_conf(num_tasks);
+    }
+
+    // Writes and sends with immediate, on devices that support them; on
+    // others their senders complete with the allocation error.
+    void set_imm_conf(uint32_t num_tasks) {
+        auto* devinfo = doca_dev_as_devinfo(dev->get());
+        if (doca_rdma_cap_task_write_imm_is_supported(devinfo) == DOCA_SUCCESS) {
+            set_write_imm_conf(num_tasks);
+        }
+        if (doca_rdma_cap_task_send_imm_is_supported(devinfo) == DOCA_SUCCESS) {
+            set_send_imm_conf(num_tasks);
+        }
     }
 
     void set_write_conf(uint32_t num_tasks);
     void set_read_conf(uint32_t num_tasks);
     void set_send_conf(uint32_t num_tasks);
+    void set_recv_conf(uint32_t num_tasks);
+    void set_write_imm_conf(uint32_t num_tasks);
+    void set_send_imm_conf(uint32_t num_tasks);
+
+    // The context only stops once every task it allocated is freed: cached
+    // tasks are freed now, in-flight ones when they are flushed.
+    void stop() override {
+        tasks.set_enabled(false);
+        Context::stop();
+    }
 
     void set_gid_index(uint32_t gid_index) {
         auto status = doca_rdma_set_gid_index(rdma.get(), gid_index);
         check_error(status, "Failed to set gid index");
     }
 
+    /**
+     * @brief Most buffers in the source list of a write or a send, for
+     *        gather_list; 1 when the device does not report it
+     */
+    uint32_t max_write_gather_len() const {
+        uint32_t len = 0;
+        auto status = doca_rdma_cap_task_write_get_max_buf_list_len(doca_dev_as_devinfo(dev->get()), &len);
+        return status == DOCA_SUCCESS && len != 0 ? len : 1;
+    }
+
+    uint32_t max_send_gather_len() const {
+        uint32_t len = 0;
+        auto status = doca_rdma_cap_task_send_get_max_buf_list_len(doca_dev_as_devinfo(dev->get()), &len);
+        return status == DOCA_SUCCESS && len != 0 ? len : 1;
+    }
+
     auto export_ctx();
 
+    /**
+     * @brief Task latencies of every connection of this context, callable from any thread
+     */
+    latency::report latency() const {
+        return latency_histograms.snapshot();
+    }
+
     rdma_connection_sender connect(tcp::tcp_socket& socket);
 
     ~Rdma() = default;
 
+    // completes with a receive_result, which carries the immediate of a
+    // send or write with immediate
     inline auto recv(Buf& buf);
 };
 
@@ -91,9 +180,15 @@ struct rdma_connection_deleter {
 struct RdmaConnection {
     std::unique_ptr<doca_rdma_connection, rdma_connection_deleter> connection;
     std::shared_ptr<Rdma> rdma;
+    // heap allocated so that operations keep reporting to it across moves
+    std::unique_ptr<latency::histograms> latency_histograms;
 
     RdmaConnection(std::shared_ptr<Rdma> rdma, doca_rdma_connection* connection)
-        : connection(connection), rdma(std::move(rdma)) {}
+        : connection(connection), rdma(std::move(rdma)) {
+        if constexpr (latency::enabled) {
+            latency_histograms = std::make_unique<latency::histograms>();
+        }
+    }
 
     ~RdmaConnection() = default;
 
@@ -107,9 +202,33 @@ struct RdmaConnection {
 
     void connect(std::span<std::byte> ctx);
 
+    /**
+     * @brief Task latencies of this connection, callable from any thread
+     */
+    latency::report latency() const {
+        return latency_histograms ? latency_histograms->snapshot() : latency::report{};
+    }
+
+    latency::probe latency_probe() const noexcept {
+        return latency::probe{&rdma->latency_histograms, latency_histograms.get()};
+    }
+
+    // `src` of a write and `buf` of a send may head a buffer list, see
+    // gather_list, of up to max_write_gather_len() and max_send_gather_len()
+    // buffers; DOCA transfers the parts in order without a staging copy.
     inline auto write(Buf src, Buf dst);
     inline auto read(Buf src, Buf dst);
     inline auto send(Buf buf);
+
+    // Like write and send, and consume a receive posted by the peer, which
+    // completes with `immediate`; a write lands no data in its buffer.
+    inline auto write_imm(Buf src, Buf dst, uint32_t immediate);
+    inline auto send_imm(Buf buf, uint32_t immediate);
+
+    // One task per (src, dst) pair and a single completion for all of them;
+    // `items` must outlive the sender's operation.
+    inline auto write_bulk(std::span<const std::pair<Buf, Buf>> items, task::bulk_options options = {});
+    inline auto read_bulk(std::span<const std::pair<Buf, Buf>> items, task::bulk_options options = {});
 };
 
 struct rdma_connection_sender {
@@ -122,6 +241,8 @@ struct rdma_connection_sender {
         stdexec::completion_signatures<stdexec::set_value_t(RdmaConnection), stdexec::set_error_t(doca_error_t),
                                        stdexec::set_stopped_t()>;
 
+    // connecting completes inside start(), on whichever thread starts it,
+    // so there is no completion scheduler to advertise
     static stdexec::env<> get_env() noexcept {
         return {};
     }
@@ -138,8 +259,16 @@ struct rdma_connection_sender {
         Receiver receiver;
 
         void start() noexcept {
+            // dropping the exported connection disconnects it
+            if (stdexec::get_stop_token(stdexec::get_env(receiver)).stop_requested()) {
+                receiver.set_stopped();
+                return;
+            }
             connection.set_user_data(doca_data{.ptr = this});
             connection.connect(ctx);
+            // connecting an exported connection completes synchronously, do
+            // not leave a pointer to this operation behind for the callbacks
+            connection.set_user_data(doca_data{.ptr = nullptr});
             receiver.set_value(std::move(connection));
         }
 
@@ -162,68 +291,48 @@ struct rdma_connection_sender {
 
     static inline void connection_on_established(doca_rdma_connection* connection, doca_data connection_data,
                                                  doca_data ctx_data) {
-        printf("connection_on_established\n");
+        DOCA_STDEXEC_TRACE_EVENT(connection_established, connection);
         auto* op = static_cast<_operation<uint8_t>*>(connection_data.ptr);
-        op->request_cb(connection, connection_data, ctx_data);
+        if (op != nullptr) {
+            op->request_cb(connection, connection_data, ctx_data);
+        }
     }
 
     static inline void connection_on_failure(doca_rdma_connection* connection, doca_data connection_data,
                                              doca_data ctx_data) {
-        printf("connection_on_failure\n");
+        DOCA_STDEXEC_TRACE_EVENT(connection_failure, connection);
         auto* op = static_cast<_operation<uint8_t>*>(connection_data.ptr);
-        op->failure_cb(connection, connection_data, ctx_data);
+        if (op != nullptr) {
+            op->failure_cb(connection, connection_data, ctx_data);
+        }
     }
 };
 
 inline void connection_request_cb(doca_rdma_connection* connection, doca_data connection_data) {
-    printf("connection_request_cb\n");
+    DOCA_STDEXEC_TRACE_EVENT(connection_request, connection);
 }
 
 inline void connection_disconnection_cb(doca_rdma_connection* connection, doca_data connection_data,
                                         doca_data ctx_data) {
-    printf("connection_disconnection_cb\n");
+    DOCA_STDEXEC_TRACE_EVENT(connection_disconnected, connection);
 }
 
 inline static void rdma_state_changed_cb(doca_data data, doca_ctx* ctx, doca_ctx_states old_state,
                                          doca_ctx_states new_state) {
-    switch (new_state) {
-        case DOCA_CTX_STATE_IDLE:
-            printf("rdma_state_changed_cb, idle\n");
-            break;
-        case DOCA_CTX_STATE_STARTING:
-            printf("rdma_state_changed_cb, starting\n");
-            break;
-        case DOCA_CTX_STATE_RUNNING:
-            printf("rdma_state_changed_cb, running\n");
-            break;
-        case DOCA_CTX_STATE_STOPPING:
-            printf("rdma_state_changed_cb, stopping\n");
-            break;
-        default:
-            printf("rdma_state_changed_cb, unknown state\n");
-            break;
-    }
+    DOCA_STDEXEC_TRACE_EVENT(context_state_changed, ctx, new_state);
 }
 
 inline Rdma::Rdma(doca_rdma* rdma, std::shared_ptr<Device> dev) : rdma(rdma), dev(std::move(dev)) {
-    printf("rdma set connection state callbacks\n");
-
     auto status = doca_rdma_set_connection_state_callbacks(
         rdma, connection_request_cb, rdma_connection_sender::connection_on_established,
         rdma_connection_sender::connection_on_failure, connection_disconnection_cb);
     check_error(status, "Failed to set connection state callbacks");
 
-    printf("set state changed cb\n");
-
     set_state_changed_cb(rdma_state_changed_cb);
 
     set_conf();
 }
 
-inline void rdma_state_changed_cb(doca_rdma* rdma, doca_data rdma_data) {
-    printf("rdma_state_changed_cb\n");
-}
-
 inline auto Rdma::export_ctx() {
     const void* local_descriptor;
     size_t local_descriptor_size;
@@ -240,7 +349,7 @@ inline auto Rdma::export_ctx() {
 }
 
 inline void RdmaConnection::connect(std::span<std::byte> ctx) {
-    printf("RdmaConnection::connect\n");
+    DOCA_STDEXEC_TRACE_EVENT(connection_connect, connection.get());
     auto status = doca_rdma_connect(rdma->get(), ctx.data(), ctx.size(), connection.get());
     check_error(status, "Failed to connect rdma");
 }
@@ -279,6 +388,24 @@ inline void Rdma::set_send_conf(uint32_t num_tasks) {
     check_error(status, "Failed to set send conf");
 }
 
+inline void Rdma::set_recv_conf(uint32_t num_tasks) {
+    auto status = doca_rdma_task_receive_set_conf(rdma.get(), task::rdma_operation_set_value<RdmaRecvTask>,
+                                                  task::rdma_operation_set_error<RdmaRecvTask>, num_tasks);
+    check_error(status, "Failed to set receive conf");
+}
+
+inline void Rdma::set_write_imm_conf(uint32_t num_tasks) {
+    auto status = doca_rdma_task_write_imm_set_conf(rdma.get(), task::rdma_operation_set_value<RdmaWriteImmTask>,
+                                                    task::rdma_operation_set_error<RdmaWriteImmTask>, num_tasks);
+    check_error(status, "Failed to set write with immediate conf");
+}
+
+inline void Rdma::set_send_imm_conf(uint32_t num_tasks) {
+    auto status = doca_rdma_task_send_imm_set_conf(rdma.get(), task::rdma_operation_set_value<RdmaSendImmTask>,
+                                                   task::rdma_operation_set_error<RdmaSendImmTask>, num_tasks);
+    check_error(status, "Failed to set send with immediate conf");
+}
+
 } // namespace doca_stdexec::rdma
 
 #endif // DOCA_STDEXEC_RDMA_HPP
\ No newline at end of file
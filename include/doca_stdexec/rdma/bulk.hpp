@@ -0,0 +1,232 @@
+#pragma once
+#ifndef DOCA_STDEXEC_RDMA_BULK_HPP
+#define DOCA_STDEXEC_RDMA_BULK_HPP
+
+#include "doca_stdexec/buf.hpp"
+#include "doca_stdexec/doorbell.hpp"
+#include "doca_stdexec/operation.hpp"
+#include "doca_stdexec/progress_engine.hpp"
+#include "doca_stdexec/rdma/latency.hpp"
+#include "doca_stdexec/rdma/task.hpp"
+#include "doca_stdexec/rdma/task_cache.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <doca_error.h>
+#include <doca_rdma.h>
+#include <memory>
+#include <optional>
+#include <span>
+#include <stdexec/execution.hpp>
+#include <tuple>
+#include <utility>
+
+namespace doca_stdexec::rdma::task {
+
+struct bulk_options {
+    // pieces in flight at once
+    size_t window = 64;
+    // Empty, the transfer stops issuing pieces at the first failure and
+    // completes with its error. Otherwise holds one status per piece, and
+    // every piece runs and the transfer completes with set_value.
+    std::span<doca_error_t> statuses{};
+};
+
+/**
+ * @brief Runs `items.size()` tasks of type Task, at most `window` at once,
+ *        and completes once for all of them
+ *
+ * Each piece is an rdma_operation whose receiver refills its slot with the
+ * next piece, so a transfer has one operation state and one completion no
+ * matter how many pieces it moves. Pieces are counted down in `remaining_`,
+ * which holds one extra count while start() issues the first window.
+ */
+template <typename Receiver, DocaTask Task>
+struct bulk_operation : immovable {
+    struct slot;
+
+    struct item_receiver {
+        using receiver_concept = stdexec::receiver_t;
+
+        bulk_operation* self;
+        slot* s;
+        size_t index;
+
+        void set_value() noexcept {
+            self->complete_item_(*s, index, DOCA_SUCCESS);
+        }
+
+        void set_error(doca_error_t error) noexcept {
+            self->complete_item_(*s, index, error);
+        }
+
+        void set_stopped() noexcept {
+            self->stopped_ = true;
+            self->complete_item_(*s, index, DOCA_SUCCESS);
+        }
+
+        [[nodiscard]]
+        auto get_env() const noexcept {
+            return stdexec::get_env(self->receiver);
+        }
+    };
+
+    using item_op = rdma_operation<item_receiver, Task, doca_buf*, doca_buf*>;
+
+    struct slot {
+        std::optional<item_op> op;
+    };
+
+    bulk_operation(doca_rdma* rdma, doca_rdma_connection* connection, loop::doca_pe_run_loop* pe_loop,
+                   task_cache* tasks, doorbell* bell, std::span<const std::pair<Buf, Buf>> items,
+                   bulk_options options, Receiver receiver, latency::probe probe = {})
+        : rdma(rdma), connection(connection), pe_loop(pe_loop), tasks(tasks), bell(bell), items(items),
+          options(options), receiver(std::move(receiver)), probe(probe),
+          slots_(std::make_unique<slot[]>(std::min(std::max<size_t>(options.window, 1), items.size()))),
+          remaining_(items.size() + 1) {}
+
+    void start() noexcept {
+        auto window = std::min(std::max<size_t>(options.window, 1), items.size());
+        {
+            doorbell::batch scope{*bell};
+            for (size_t i = 0; i < window && !stopping_(); i++) {
+                start_item_(slots_[i], next_++);
+            }
+        }
+        // start's own count
+        size_t finished = 1;
+        if (stopping_()) {
+            finished += drop_unissued_();
+        }
+        finish_(finished);
+    }
+
+    doca_rdma* rdma;
+    doca_rdma_connection* connection;
+    loop::doca_pe_run_loop* pe_loop;
+    task_cache* tasks;
+    doorbell* bell;
+    std::span<const std::pair<Buf, Buf>> items;
+    bulk_options options;
+    Receiver receiver;
+    [[no_unique_address]] latency::probe probe;
+
+private:
+    bool stopping_() const noexcept {
+        return stopped_ || (options.statuses.empty() && first_error_ != DOCA_SUCCESS) ||
+               stdexec::get_stop_token(stdexec::get_env(receiver)).stop_requested();
+    }
+
+    void start_item_(slot& s, size_t index) noexcept {
+        auto connect = [&] {
+            return item_op{rdma,
+                           connection,
+                           pe_loop,
+                           tasks,
+                           bell,
+                           std::make_tuple(items[index].first.get(), items[index].second.get()),
+                           item_receiver{this, &s, index},
+                           probe};
+        };
+        s.op.emplace(emplace_from<item_op, decltype(connect)>{connect});
+        s.op->start();
+    }
+
+    // PE thread, from the completion of piece `index`, which is destroyed
+    // here; may start the next piece in the same slot
+    void complete_item_(slot& s, size_t index, doca_error_t status) noexcept {
+        if (!options.statuses.empty()) {
+            options.statuses[index] = status;
+        } else if (status != DOCA_SUCCESS && first_error_ == DOCA_SUCCESS) {
+            first_error_ = status;
+        }
+        s.op.reset();
+
+        size_t finished = 1;
+        if (next_ < items.size()) {
+            if (stopping_()) {
+                finished += drop_unissued_();
+            } else {
+                // a piece completing inside its start, on a stop request,
+                // counts itself down while this one is still outstanding
+                start_item_(s, next_++);
+            }
+        }
+        finish_(finished);
+    }
+
+    // the pieces that will never be issued; only a stop request drops any
+    // without an error to complete with
+    size_t drop_unissued_() noexcept {
+        auto dropped = items.size() - std::exchange(next_, items.size());
+        if (dropped != 0 && first_error_ == DOCA_SUCCESS) {
+            stopped_ = true;
+        }
+        return dropped;
+    }
+
+    void finish_(size_t finished) noexcept {
+        if (remaining_.fetch_sub(finished, std::memory_order_acq_rel) != finished) {
+            return;
+        }
+        if (first_error_ != DOCA_SUCCESS) {
+            receiver.set_error(std::move(first_error_));
+        } else if (stopped_) {
+            receiver.set_stopped();
+        } else {
+            receiver.set_value();
+        }
+    }
+
+    std::unique_ptr<slot[]> slots_;
+    std::atomic<size_t> remaining_;
+    size_t next_ = 0;
+    doca_error_t first_error_ = DOCA_SUCCESS;
+    bool stopped_ = false;
+};
+
+/**
+ * @brief A Task for each (src, dst) pair of `items`, completing once
+ *
+ * The pairs, and the buffers in them, must stay alive until the transfer
+ * completes. Completes with set_value, with the first error of a piece
+ * unless per-piece statuses are requested, or with set_stopped when a stop
+ * request kept pieces from running.
+ */
+template <DocaTask Task>
+struct bulk_sender {
+    using sender_concept = stdexec::sender_t;
+
+    using completion_signatures = stdexec::completion_signatures<stdexec::set_value_t(),
+                                                                 stdexec::set_error_t(doca_error_t),
+                                                                 stdexec::set_stopped_t()>;
+
+    [[nodiscard]]
+    auto get_env() const noexcept -> loop::completion_env {
+        return {pe_loop->get_scheduler()};
+    }
+
+    [[nodiscard]]
+    doorbell* get_doorbell() const noexcept {
+        return bell;
+    }
+
+    template <stdexec::receiver Receiver>
+    auto connect(Receiver rcvr) {
+        return bulk_operation<Receiver, Task>{rdma, connection, pe_loop, tasks, bell,
+                                              items, options, std::move(rcvr), probe};
+    }
+
+    doca_rdma* rdma;
+    doca_rdma_connection* connection;
+    loop::doca_pe_run_loop* pe_loop;
+    task_cache* tasks;
+    doorbell* bell;
+    std::span<const std::pair<Buf, Buf>> items;
+    bulk_options options{};
+    [[no_unique_address]] latency::probe probe{};
+};
+
+} // namespace doca_stdexec::rdma::task
+
+#endif // DOCA_STDEXEC_RDMA_BULK_HPP
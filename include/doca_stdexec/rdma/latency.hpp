@@ -0,0 +1,162 @@
+#pragma once
+#ifndef DOCA_STDEXEC_RDMA_LATENCY_HPP
+#define DOCA_STDEXEC_RDMA_LATENCY_HPP
+
+#include "doca_stdexec/common/histogram.hpp"
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Submit-to-completion latency of RDMA tasks.
+ *
+ * Every successful task records its latency in nanoseconds twice: into the
+ * histogram of its opcode on the Rdma context and on its RdmaConnection.
+ * Both can be snapshotted from any thread while traffic runs, and reports
+ * of several contexts (one per PE thread) merge into one.
+ *
+ * On by default; define DOCA_STDEXEC_LATENCY_HISTOGRAMS=0 (meson
+ * -Dlatency_histograms=false, xmake f --latency_histograms=n) to drop the
+ * clock reads and the histograms. Reports are then always empty.
+ */
+#ifndef DOCA_STDEXEC_LATENCY_HISTOGRAMS
+#define DOCA_STDEXEC_LATENCY_HISTOGRAMS 1
+#endif
+
+namespace doca_stdexec::rdma::latency {
+
+inline constexpr bool enabled = DOCA_STDEXEC_LATENCY_HISTOGRAMS != 0;
+
+enum class opcode : uint8_t {
+    write,
+    read,
+    send,
+    recv,
+    write_imm,
+    send_imm,
+};
+
+inline constexpr size_t opcode_count = 6;
+
+inline const char* name(opcode op) noexcept {
+    switch (op) {
+        case opcode::write:
+            return "write";
+        case opcode::read:
+            return "read";
+        case opcode::send:
+            return "send";
+        case opcode::recv:
+            return "recv";
+        case opcode::write_imm:
+            return "write_imm";
+        case opcode::send_imm:
+            return "send_imm";
+    }
+    return "unknown";
+}
+
+/**
+ * @brief Snapshots of one histogram per opcode
+ */
+struct report {
+    std::array<histogram_snapshot, opcode_count> by_opcode;
+
+    const histogram_snapshot& operator[](opcode op) const noexcept {
+        return by_opcode[static_cast<size_t>(op)];
+    }
+
+    report& merge(const report& other) noexcept {
+        for (size_t i = 0; i < opcode_count; i++) {
+            by_opcode[i].merge(other.by_opcode[i]);
+        }
+        return *this;
+    }
+
+    // see histogram_snapshot::since
+    report since(const report& earlier) const {
+        report window;
+        for (size_t i = 0; i < opcode_count; i++) {
+            window.by_opcode[i] = by_opcode[i].since(earlier.by_opcode[i]);
+        }
+        return window;
+    }
+};
+
+#if DOCA_STDEXEC_LATENCY_HISTOGRAMS
+
+class histograms {
+public:
+    void record(opcode op, uint64_t nanoseconds) noexcept {
+        by_opcode_[static_cast<size_t>(op)].record(nanoseconds);
+    }
+
+    report snapshot() const {
+        report result;
+        for (size_t i = 0; i < opcode_count; i++) {
+            result.by_opcode[i] = by_opcode_[i].snapshot();
+        }
+        return result;
+    }
+
+private:
+    std::array<latency_histogram, opcode_count> by_opcode_;
+};
+
+/**
+ * @brief Per-operation timestamp and the histograms it reports to
+ */
+class probe {
+public:
+    using clock = std::chrono::steady_clock;
+
+    probe() = default;
+    probe(histograms* context, histograms* connection) noexcept : context_(context), connection_(connection) {}
+
+    void on_submit() noexcept {
+        submitted_ = clock::now();
+    }
+
+    void on_complete(opcode op) noexcept {
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - submitted_).count();
+        auto nanoseconds = static_cast<uint64_t>(elapsed);
+        if (context_ != nullptr) {
+            context_->record(op, nanoseconds);
+        }
+        if (connection_ != nullptr) {
+            connection_->record(op, nanoseconds);
+        }
+    }
+
+private:
+    histograms* context_ = nullptr;
+    histograms* connection_ = nullptr;
+    clock::time_point submitted_;
+};
+
+#else
+
+class histograms {
+public:
+    void record(opcode, uint64_t) noexcept {}
+
+    report snapshot() const {
+        return {};
+    }
+};
+
+class probe {
+public:
+    probe() = default;
+    probe(histograms*, histograms*) noexcept {}
+
+    void on_submit() noexcept {}
+    void on_complete(opcode) noexcept {}
+};
+
+#endif
+
+} // namespace doca_stdexec::rdma::latency
+
+#endif // DOCA_STDEXEC_RDMA_LATENCY_HPP
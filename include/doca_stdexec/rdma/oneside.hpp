@@ -1,5 +1,6 @@
 #pragma once
 #include "doca_buf.h"
+#include <arpa/inet.h>
 #include <cstdio>
 #ifndef DOCA_STDEXEC_RDMA_ONESIDE_HPP
 #define DOCA_STDEXEC_RDMA_ONESIDE_HPP
@@ -7,130 +8,123 @@
 #include "doca_stdexec/rdma.hpp"
 #include <doca_pe.h>
 #include <doca_rdma.h>
-#include <stdexcept>
 #include <stdexec/execution.hpp>
 #include "doca_stdexec/common.hpp"
+#include "doca_stdexec/trace.hpp"
 
 namespace doca_stdexec::rdma {
 
-struct rdma_write_deleter {
-  void operator()(doca_rdma_task_write *task) {
-    printf("write task deleter\n");
-    doca_task_free(doca_rdma_task_write_as_task(task));
-  }
-};
-
-struct RdmaWriteTask {
-  using raw_type = doca_rdma_task_write;
-
-public:
-  RdmaWriteTask(doca_rdma_task_write *task) : task(task) {}
-
-  RdmaWriteTask(RdmaWriteTask &&other) = default;
-
-  static RdmaWriteTask allocate(doca_rdma *rdma, doca_rdma_connection *conn,
-                                doca_buf *src, doca_buf *dst) {
-
-    doca_error status;
-
-    void *src_head;
-    void *src_data;
-    size_t src_data_len;
-    status = doca_buf_get_head(src, &src_head);
-    check_error(status, "Failed to get src head");
-    status = doca_buf_get_data(src, &src_data);
-    check_error(status, "Failed to get src data");
-    status = doca_buf_get_data_len(src, &src_data_len);
-    check_error(status, "Failed to get src data len");
-
-    printf("src buf head %p, data %p,%zu\n", src_head, src_data, src_data_len);
+struct RdmaWriteTask
+    : task::pooled_task<doca_rdma_task_write, doca_rdma_task_write_as_task> {
+  static constexpr latency::opcode opcode = latency::opcode::write;
 
-    void *dst_head;
-    void *dst_data;
-    size_t dst_data_len;
-    status = doca_buf_get_head(dst, &dst_head);
-    check_error(status, "Failed to get dst head");
-    status = doca_buf_get_data(dst, &dst_data);
-    check_error(status, "Failed to get dst data");
-    status = doca_buf_get_data_len(dst, &dst_data_len);
-    check_error(status, "Failed to get dst data len");
-    printf("dst buf head %p, data %p,%zu\n", dst_head, dst_data, dst_data_len);
+  using pooled_task::pooled_task;
 
+  static doca_error_t allocate(doca_rdma *rdma, doca_rdma_connection *conn,
+                               doca_buf *src, doca_buf *dst,
+                               doca_rdma_task_write **task) {
     union doca_data user_data;
     user_data.u64 = 0;
-
-    doca_rdma_task_write *task = nullptr;
-
-    printf("Allocating write task: rdma %p, conn %p, src %p, dst %p\n", rdma,
-           conn, src, dst);
-
-    auto err = doca_rdma_task_write_allocate_init(rdma, conn, src, dst,
-                                                  user_data, &task);
-    if (err != DOCA_SUCCESS) {
-      throw std::runtime_error("Failed to allocate write task");
-    }
-
-    return RdmaWriteTask(task);
+    return doca_rdma_task_write_allocate_init(rdma, conn, src, dst, user_data,
+                                              task);
   }
 
-  doca_task *as_task() { return doca_rdma_task_write_as_task(task.get()); }
-
-  void submit() {
-    auto err = doca_task_submit(doca_rdma_task_write_as_task(task.get()));
-    check_error(err, "Failed to submit write task");
+  static void retarget(doca_rdma_task_write *task, doca_rdma_connection *conn,
+                       doca_buf *src, doca_buf *dst) {
+    doca_rdma_task_write_set_rdma_connection(task, conn);
+    doca_rdma_task_write_set_src_buf(task, src);
+    doca_rdma_task_write_set_dst_buf(task, dst);
   }
-
-private:
-  std::unique_ptr<doca_rdma_task_write, rdma_write_deleter> task;
 };
 
 inline auto RdmaConnection::write(Buf src, Buf dst) {
   auto sender = rdma::task::rdma_sender<RdmaWriteTask, doca_buf *, doca_buf *>{
-      rdma->get(), connection.get(), std::make_tuple(src.get(), dst.get())};
+      rdma->get(), connection.get(), rdma->connected_loop, &rdma->tasks,
+      &rdma->bell, std::make_tuple(src.get(), dst.get()), latency_probe()};
   return sender;
 }
 
-struct RdmaReadTask {
-  using raw_type = doca_rdma_task_read;
+struct RdmaReadTask
+    : task::pooled_task<doca_rdma_task_read, doca_rdma_task_read_as_task> {
+  static constexpr latency::opcode opcode = latency::opcode::read;
 
-  RdmaReadTask(doca_rdma_task_read *task) : task(task) {}
-
-  static RdmaReadTask allocate(doca_rdma *rdma, doca_rdma_connection *conn,
-                               doca_buf *src, doca_buf *dst) {
+  using pooled_task::pooled_task;
 
+  static doca_error_t allocate(doca_rdma *rdma, doca_rdma_connection *conn,
+                               doca_buf *src, doca_buf *dst,
+                               doca_rdma_task_read **task) {
     union doca_data user_data;
     user_data.u64 = 0;
+    return doca_rdma_task_read_allocate_init(rdma, conn, src, dst, user_data,
+                                             task);
+  }
 
-    doca_rdma_task_read *task = nullptr;
+  static void retarget(doca_rdma_task_read *task, doca_rdma_connection *conn,
+                       doca_buf *src, doca_buf *dst) {
+    doca_rdma_task_read_set_rdma_connection(task, conn);
+    doca_rdma_task_read_set_src_buf(task, src);
+    doca_rdma_task_read_set_dst_buf(task, dst);
+  }
+};
 
-    auto err = doca_rdma_task_read_allocate_init(rdma, conn, src, dst,
-                                                 user_data, &task);
-    if (err != DOCA_SUCCESS) {
-      throw std::runtime_error("Failed to allocate read task");
-    }
+inline auto RdmaConnection::read(Buf src, Buf dst) {
+  auto sender = rdma::task::rdma_sender<RdmaReadTask, doca_buf *, doca_buf *>{
+      rdma->get(), connection.get(), rdma->connected_loop, &rdma->tasks,
+      &rdma->bell, std::make_tuple(src.get(), dst.get()), latency_probe()};
+  return sender;
+}
 
-    return RdmaReadTask(task);
-  }
+struct RdmaWriteImmTask : task::pooled_task<doca_rdma_task_write_imm,
+                                             doca_rdma_task_write_imm_as_task> {
+  static constexpr latency::opcode opcode = latency::opcode::write_imm;
 
-  doca_task *as_task() { return doca_rdma_task_read_as_task(task); }
+  using pooled_task::pooled_task;
 
-  void submit() {
-    auto err = doca_task_submit(doca_rdma_task_read_as_task(task));
-    check_error(err, "Failed to submit read task");
+  static doca_error_t allocate(doca_rdma *rdma, doca_rdma_connection *conn,
+                               doca_buf *src, doca_buf *dst,
+                               doca_be32_t immediate,
+                               doca_rdma_task_write_imm **task) {
+    union doca_data user_data;
+    user_data.u64 = 0;
+    return doca_rdma_task_write_imm_allocate_init(rdma, conn, src, dst,
+                                                  immediate, user_data, task);
   }
 
-  ~RdmaReadTask() { doca_task_free(doca_rdma_task_read_as_task(task)); }
-
-private:
-  doca_rdma_task_read *task;
+  static void retarget(doca_rdma_task_write_imm *task,
+                       doca_rdma_connection *conn, doca_buf *src,
+                       doca_buf *dst, doca_be32_t immediate) {
+    doca_rdma_task_write_imm_set_rdma_connection(task, conn);
+    doca_rdma_task_write_imm_set_src_buf(task, src);
+    doca_rdma_task_write_imm_set_dst_buf(task, dst);
+    doca_rdma_task_write_imm_set_immediate_data(task, immediate);
+  }
 };
 
-inline auto RdmaConnection::read(Buf src, Buf dst) {
-  auto sender = rdma::task::rdma_sender<RdmaReadTask, doca_buf *, doca_buf *>{
-      rdma->get(), connection.get(), std::make_tuple(src.get(), dst.get())};
+inline auto RdmaConnection::write_imm(Buf src, Buf dst, uint32_t immediate) {
+  auto sender = rdma::task::rdma_sender<RdmaWriteImmTask, doca_buf *,
+                                        doca_buf *, doca_be32_t>{
+      rdma->get(), connection.get(), rdma->connected_loop, &rdma->tasks,
+      &rdma->bell, std::make_tuple(src.get(), dst.get(), htonl(immediate)),
+      latency_probe()};
   return sender;
 }
 
+inline auto
+RdmaConnection::write_bulk(std::span<const std::pair<Buf, Buf>> items,
+                           task::bulk_options options) {
+  return rdma::task::bulk_sender<RdmaWriteTask>{
+      rdma->get(), connection.get(), rdma->connected_loop, &rdma->tasks,
+      &rdma->bell, items, options, latency_probe()};
+}
+
+inline auto
+RdmaConnection::read_bulk(std::span<const std::pair<Buf, Buf>> items,
+                          task::bulk_options options) {
+  return rdma::task::bulk_sender<RdmaReadTask>{
+      rdma->get(), connection.get(), rdma->connected_loop, &rdma->tasks,
+      &rdma->bell, items, options, latency_probe()};
+}
+
 } // namespace doca_stdexec::rdma
 
 #endif // DOCA_STDEXEC_RDMA_ONESIDE_HPP
\ No newline at end of file
@@ -8,76 +8,313 @@
 #ifndef DOCA_STDEXEC_RDMA_TASK_HPP
 #define DOCA_STDEXEC_RDMA_TASK_HPP
 
+#include "doca_stdexec/doorbell.hpp"
+#include "doca_stdexec/loop_counters.hpp"
 #include "doca_stdexec/operation.hpp"
+#include "doca_stdexec/progress_engine.hpp"
+#include "doca_stdexec/rdma/latency.hpp"
+#include "doca_stdexec/rdma/task_cache.hpp"
+#include "doca_stdexec/trace.hpp"
 #include <doca_error.h>
 #include <doca_pe.h>
+#include <atomic>
+#include <chrono>
 #include <doca_stdexec/operation.hpp>
+#include <exception>
+#include <optional>
 #include <stdexec/execution.hpp>
+#include <tuple>
 
 namespace doca_stdexec::rdma::task {
 
 template <typename T>
 concept DocaTask = requires(T t) {
     { t.as_task() } -> std::same_as<doca_task*>;
+    { t.release() } noexcept;
+    { T::opcode } -> std::convertible_to<latency::opcode>;
 };
 
-template <typename Receiver, DocaTask DocaTask>
-struct rdma_operation : immovable {
-    using set_value_cb = void (*)(rdma_operation*);
-    using set_error_cb = void (*)(rdma_operation*, doca_error_t);
-    using set_stopped_cb = void (*)(rdma_operation*);
+// A task with a result, like a receive, completes with Task::result(raw),
+// read before the task goes back to the cache; any other with no value.
+template <typename Task>
+concept has_task_result = requires(typename Task::raw_type* raw) { Task::result(raw); };
 
-    set_value_cb set_value_callback = set_value;
-    set_error_cb set_error_callback = set_error;
-    set_stopped_cb set_stopped_callback = set_stopped;
+template <typename Task>
+struct task_value {
+    using signature = stdexec::set_value_t();
+};
+
+template <has_task_result Task>
+struct task_value<Task> {
+    using signature = stdexec::set_value_t(decltype(Task::result(std::declval<typename Task::raw_type*>())));
+};
+
+/**
+ * @brief The part of an operation the completion callbacks see
+ *
+ * A submitted task's user data points here; the callbacks dispatch to the
+ * operation through these pointers.
+ */
+template <DocaTask Task>
+struct rdma_operation_base : immovable, Task::free_list::waiter {
+    void (*set_value_callback)(rdma_operation_base*) noexcept;
+    void (*set_error_callback)(rdma_operation_base*, doca_error_t) noexcept;
+    void (*set_stopped_callback)(rdma_operation_base*) noexcept;
+};
 
-    rdma_operation(DocaTask task, Receiver receiver) : task(std::move(task)), receiver(std::move(receiver)) {}
+/**
+ * @brief Runs one task: `Task::allocate(rdma, connection, buffers..., &raw)`
+ *        or a cached task re-targeted with `Task::retarget`
+ *
+ * The task is only taken in start(). When DOCA's pool of the task type is
+ * exhausted, the operation parks in the cache's wait list and is submitted
+ * from the completion that releases the next task; a stop request takes it
+ * out of the list again and completes it with set_stopped.
+ */
+template <typename Receiver, DocaTask Task, typename... Buffers>
+struct rdma_operation : rdma_operation_base<Task> {
+    using base = rdma_operation_base<Task>;
+    using raw_type = typename Task::raw_type;
+    using free_list = typename Task::free_list;
+    using stop_token_t = stdexec::stop_token_of_t<stdexec::env_of_t<Receiver>>;
 
-    static void set_value(rdma_operation* op) {
-        op->receiver.set_value();
+    rdma_operation(doca_rdma* rdma, doca_rdma_connection* connection, loop::doca_pe_run_loop* pe_loop,
+                   task_cache* tasks, doorbell* bell, std::tuple<Buffers...> buffers, Receiver receiver,
+                   latency::probe probe = {})
+        : rdma(rdma), connection(connection), pe_loop(pe_loop), tasks(tasks), bell(bell),
+          buffers(std::move(buffers)), receiver(std::move(receiver)), probe(probe) {
+        this->set_value_callback = set_value;
+        this->set_error_callback = set_error;
+        this->set_stopped_callback = set_stopped;
+        this->resume = resume_;
     }
 
-    static void set_error(rdma_operation* op, doca_error_t error) {
+    // The task goes back to the cache before the receiver runs, so that a
+    // parked operation or one started from the completion can reuse it.
+    static void set_value(base* b) noexcept {
+        auto* op = static_cast<rdma_operation*>(b);
+        op->probe.on_complete(Task::opcode);
+        auto complete = [op](auto&&... result) noexcept {
+            op->task.release();
+            DOCA_STDEXEC_TRACE_EVENT(task_complete, op, DOCA_SUCCESS);
+            DOCA_STDEXEC_TRACE_EVENT(receiver_begin, op);
+            op->receiver.set_value(static_cast<decltype(result)&&>(result)...);
+            DOCA_STDEXEC_TRACE_EVENT(receiver_end, op);
+        };
+        if constexpr (has_task_result<Task>) {
+            complete(Task::result(op->task.get()));
+        } else {
+            complete();
+        }
+    }
+
+    static void set_error(base* b, doca_error_t error) noexcept {
+        auto* op = static_cast<rdma_operation*>(b);
+        op->task.release();
+        DOCA_STDEXEC_TRACE_EVENT(task_complete, op, error);
+        // DOCA cannot abort a single submitted task; a task that fails after
+        // stop was requested (flushed by a disconnect or a context stop) is
+        // reported as stopped instead
+        if (op->stop_requested()) {
+            set_stopped(op);
+            return;
+        }
+        DOCA_STDEXEC_TRACE_EVENT(receiver_begin, op);
         op->receiver.set_error(std::move(error));
-        check_error(error, "Operation Error");
+        DOCA_STDEXEC_TRACE_EVENT(receiver_end, op);
     }
 
-    static void set_stopped(rdma_operation* op) {
-        // TODO: Implement this
+    static void set_stopped(base* b) noexcept {
+        auto* op = static_cast<rdma_operation*>(b);
+        op->task.release();
+        DOCA_STDEXEC_TRACE_EVENT(task_stopped, op);
+        DOCA_STDEXEC_TRACE_EVENT(receiver_begin, op);
+        op->receiver.set_stopped();
+        DOCA_STDEXEC_TRACE_EVENT(receiver_end, op);
+    }
+
+    bool stop_requested() const noexcept {
+        return stdexec::get_stop_token(stdexec::get_env(receiver)).stop_requested();
     }
 
     void start() noexcept {
-        doca_task_set_user_data(task.as_task(), doca_data{.ptr = this});
-        auto status = doca_task_submit(task.as_task());
-        check_error(status, "Failed to submit task");
+        // work nobody waits for any more is dropped before it reaches the NIC
+        if (stop_requested()) {
+            set_stopped(this);
+            return;
+        }
+        // queue behind operations that are already waiting for a task
+        if (tasks->template list<free_list>().has_waiters()) {
+            park_();
+            return;
+        }
+        auto status = try_acquire_();
+        if (status == DOCA_ERROR_NO_MEMORY) {
+            park_();
+            return;
+        }
+        // e.g. a task type the context was not configured for
+        if (status != DOCA_SUCCESS) {
+            set_error(this, status);
+            return;
+        }
+        submit_();
     }
-    DocaTask task;
+
+    doca_rdma* rdma;
+    doca_rdma_connection* connection;
+    loop::doca_pe_run_loop* pe_loop;
+    task_cache* tasks;
+    doorbell* bell;
+    std::tuple<Buffers...> buffers;
+    Task task;
     Receiver receiver;
+    [[no_unique_address]] latency::probe probe;
+
+private:
+    struct on_stop {
+        rdma_operation* self;
+
+        void operator()() const noexcept {
+            self->cancel_requested_.store(true, std::memory_order_release);
+            // the wait list belongs to the PE thread; schedule_before is
+            // never run inline, also when stop is requested on that thread
+            auto connect = [s = self] {
+                return stdexec::connect(
+                    s->pe_loop->get_scheduler().schedule_before(std::chrono::steady_clock::time_point::min()),
+                    cancel_receiver{s});
+            };
+            stdexec::start(self->cancel_.emplace(emplace_from<cancel_op, decltype(connect)>{connect}));
+        }
+    };
+
+    struct cancel_receiver {
+        using receiver_concept = stdexec::receiver_t;
+
+        rdma_operation* self;
+
+        void set_value() noexcept {
+            self->cancel_parked_();
+        }
+
+        // the cancellation never reached the PE thread; nothing can
+        // complete the operation any more
+        void set_error(std::exception_ptr) noexcept {
+            std::terminate();
+        }
+
+        void set_stopped() noexcept {
+            std::terminate();
+        }
+
+        [[nodiscard]]
+        stdexec::env<> get_env() const noexcept {
+            return {};
+        }
+    };
+
+    using cancel_op = stdexec::connect_result_t<
+        decltype(std::declval<loop::doca_pe_run_loop::scheduler>().schedule_before({})), cancel_receiver>;
+
+    // takes a cached task or allocates one; DOCA_ERROR_NO_MEMORY when DOCA's
+    // pool is exhausted
+    doca_error_t try_acquire_() noexcept {
+        auto* raw = tasks->template take<free_list>();
+        if (raw != nullptr) {
+            retarget_(raw);
+        } else {
+            auto status =
+                std::apply([&](auto... buffer) { return Task::allocate(rdma, connection, buffer..., &raw); }, buffers);
+            if (status != DOCA_SUCCESS) {
+                return status;
+            }
+            tasks->count_allocation();
+            DOCA_STDEXEC_TRACE_EVENT(task_allocate, raw, reinterpret_cast<uintptr_t>(connection));
+        }
+        task = Task{raw, tasks->template list<free_list>()};
+        return DOCA_SUCCESS;
+    }
+
+    void retarget_(raw_type* raw) noexcept {
+        std::apply([&](auto... buffer) { Task::retarget(raw, connection, buffer...); }, buffers);
+        DOCA_STDEXEC_TRACE_EVENT(task_reuse, raw, reinterpret_cast<uintptr_t>(connection));
+    }
+
+    void submit_() noexcept {
+        doca_task_set_user_data(task.as_task(), doca_data{.ptr = static_cast<base*>(this)});
+        DOCA_STDEXEC_TRACE_EVENT(task_submit, this);
+        probe.on_submit();
+        if (auto* counters = loop::run_loop_counters::current) {
+            counters->task_submitted();
+        }
+        bell->submit(task.as_task(), connection);
+    }
+
+    void park_() noexcept {
+        tasks->template park<free_list>(*this);
+        if constexpr (!stdexec::unstoppable_token<stop_token_t>) {
+            // a stop request racing with this only queues the cancellation
+            on_stop_.emplace(stdexec::get_stop_token(stdexec::get_env(receiver)), on_stop{this});
+        }
+    }
+
+    // PE thread; `raw` is the released task, or nullptr when the cache was
+    // disabled and the operation is dropped
+    static bool resume_(typename free_list::waiter* w, raw_type* raw) noexcept {
+        auto* op = static_cast<rdma_operation*>(w);
+        if constexpr (!stdexec::unstoppable_token<stop_token_t>) {
+            // waits for a concurrently running on_stop; if it ran, the
+            // queued cancellation completes the operation
+            op->on_stop_.reset();
+            if (op->cancel_requested_.load(std::memory_order_acquire)) {
+                return false;
+            }
+        }
+        if (raw == nullptr) {
+            set_stopped(op);
+            return false;
+        }
+        op->retarget_(raw);
+        op->task = Task{raw, op->tasks->template list<free_list>()};
+        op->submit_();
+        return true;
+    }
+
+    // PE thread, after a stop request
+    void cancel_parked_() noexcept {
+        if (this->parked) {
+            tasks->template list<free_list>().unpark(*this);
+        }
+        on_stop_.reset();
+        set_stopped(this);
+    }
+
+    std::optional<stdexec::stop_callback_for_t<stop_token_t, on_stop>> on_stop_;
+    std::atomic<bool> cancel_requested_ = false;
+    std::optional<cancel_op> cancel_;
 };
 
+// The operation owns the task; the callbacks only find it through the user data.
+
 template <DocaTask TaskType>
 inline void rdma_operation_set_value(typename TaskType::raw_type* raw_task, doca_data user_data, doca_data ctx_data) {
-    auto task = TaskType{raw_task};
-    task.~TaskType(); // destroy the task
-    auto* op = static_cast<rdma_operation<uint8_t, TaskType>*>(user_data.ptr);
+    loop::completion_scope scope;
+    auto* op = static_cast<rdma_operation_base<TaskType>*>(user_data.ptr);
     op->set_value_callback(op);
 }
 
 template <DocaTask TaskType>
 inline void rdma_operation_set_error(typename TaskType::raw_type* raw_task, doca_data user_data, doca_data ctx_data) {
-    auto* op = static_cast<rdma_operation<uint8_t, TaskType>*>(user_data.ptr);
-    auto task = TaskType{raw_task};
-    auto error = doca_task_get_status(task.as_task());
-
-    printf("\n task: %p\n", &task);
-
+    loop::completion_scope scope;
+    auto* op = static_cast<rdma_operation_base<TaskType>*>(user_data.ptr);
+    auto error = doca_task_get_status(TaskType::as_task(raw_task));
     op->set_error_callback(op, error);
 }
 
 template <DocaTask TaskType>
 inline void rdma_operation_set_stopped(typename TaskType::raw_type* raw_task, doca_data user_data, doca_data ctx_data) {
-    auto task = TaskType{raw_task};
-    auto* op = static_cast<rdma_operation<uint8_t, TaskType>*>(user_data.ptr);
+    loop::completion_scope scope;
+    auto* op = static_cast<rdma_operation_base<TaskType>*>(user_data.ptr);
     op->set_stopped_callback(op);
 }
 
@@ -86,25 +323,34 @@ struct rdma_sender {
     using sender_concept = stdexec::sender_t;
 
     using completion_signatures =
-        stdexec::completion_signatures<stdexec::set_value_t(), stdexec::set_error_t(doca_error_t)>;
+        stdexec::completion_signatures<typename task_value<Task>::signature, stdexec::set_error_t(doca_error_t),
+                                       stdexec::set_stopped_t()>;
+
+    // completes on the PE thread of the loop the Rdma context is connected to
+    [[nodiscard]]
+    auto get_env() const noexcept -> loop::completion_env {
+        return {pe_loop->get_scheduler()};
+    }
 
-    stdexec::env<> get_env() {
-        return {};
+    // the doorbell its task is submitted through, for batch()
+    [[nodiscard]]
+    doorbell* get_doorbell() const noexcept {
+        return bell;
     }
 
     template <stdexec::receiver Receiver>
     auto connect(Receiver rcvr) {
-        return std::apply(
-            [&](auto&... buffers) {
-                auto task = Task::allocate(rdma, connection, buffers...);
-                return rdma_operation<Receiver, Task>{std::move(task), std::move(rcvr)};
-            },
-            _buffers);
+        return rdma_operation<Receiver, Task, Buffers...>{
+            rdma, connection, pe_loop, tasks, bell, _buffers, std::move(rcvr), probe};
     }
 
     doca_rdma* rdma;
     doca_rdma_connection* connection;
+    loop::doca_pe_run_loop* pe_loop;
+    task_cache* tasks;
+    doorbell* bell;
     std::tuple<Buffers...> _buffers;
+    [[no_unique_address]] latency::probe probe{};
 };
 
 } // namespace doca_stdexec::rdma::task
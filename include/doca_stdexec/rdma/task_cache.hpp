@@ -0,0 +1,255 @@
+#pragma once
+#ifndef DOCA_STDEXEC_RDMA_TASK_CACHE_HPP
+#define DOCA_STDEXEC_RDMA_TASK_CACHE_HPP
+
+#include "doca_stdexec/trace.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <doca_pe.h>
+#include <doca_rdma.h>
+#include <memory>
+#include <tuple>
+
+namespace doca_stdexec::rdma::task {
+
+/**
+ * @brief Initialized DOCA tasks of one type that no operation holds
+ *
+ * A cached task keeps everything allocate_init set up, the next operation
+ * only re-targets its buffers and connection. The list is threaded through
+ * the tasks' user data, which start() overwrites anyway, so caching
+ * allocates nothing.
+ *
+ * Operations that found DOCA's pool exhausted wait here in FIFO order and
+ * are handed released tasks before the cache keeps any. PE thread only,
+ * like the tasks themselves.
+ */
+template <typename Raw, doca_task* (*AsTask)(Raw*)>
+class task_free_list {
+public:
+    /**
+     * @brief An operation parked until a task of this type is released
+     *
+     * `resume` is handed the task, or nullptr when the cache is disabled and
+     * none will come, and returns whether it took it.
+     */
+    struct waiter {
+        waiter* next = nullptr;
+        waiter* prev = nullptr;
+        bool (*resume)(waiter*, Raw*) noexcept = nullptr;
+        bool parked = false;
+    };
+
+    task_free_list() = default;
+    task_free_list(const task_free_list&) = delete;
+    task_free_list& operator=(const task_free_list&) = delete;
+
+    ~task_free_list() {
+        clear();
+    }
+
+    Raw* pop() noexcept {
+        auto* task = head_;
+        if (task != nullptr) {
+            head_ = static_cast<Raw*>(doca_task_get_user_data(AsTask(task)).ptr);
+            size_--;
+        }
+        return task;
+    }
+
+    // hands `task` to the first waiter that takes it, else caches it, or
+    // frees it while caching is disabled
+    void push(Raw* task) noexcept {
+        while (auto* w = pop_waiter_()) {
+            if (w->resume(w, task)) {
+                return;
+            }
+        }
+        if (!enabled_) {
+            free_(task);
+            return;
+        }
+        doca_task_set_user_data(AsTask(task), doca_data{.ptr = head_});
+        head_ = task;
+        size_++;
+    }
+
+    void clear() noexcept {
+        while (auto* task = pop()) {
+            free_(task);
+        }
+    }
+
+    void set_enabled(bool enabled) noexcept {
+        enabled_ = enabled;
+        if (!enabled) {
+            clear();
+            while (auto* w = pop_waiter_()) {
+                w->resume(w, nullptr);
+            }
+        }
+    }
+
+    void park(waiter& w) noexcept {
+        w.next = nullptr;
+        w.prev = waiters_tail_;
+        if (waiters_tail_ != nullptr) {
+            waiters_tail_->next = &w;
+        } else {
+            waiters_head_ = &w;
+        }
+        waiters_tail_ = &w;
+        w.parked = true;
+    }
+
+    void unpark(waiter& w) noexcept {
+        (w.prev != nullptr ? w.prev->next : waiters_head_) = w.next;
+        (w.next != nullptr ? w.next->prev : waiters_tail_) = w.prev;
+        w.next = w.prev = nullptr;
+        w.parked = false;
+    }
+
+    [[nodiscard]]
+    bool has_waiters() const noexcept {
+        return waiters_head_ != nullptr;
+    }
+
+    [[nodiscard]]
+    size_t size() const noexcept {
+        return size_;
+    }
+
+private:
+    waiter* pop_waiter_() noexcept {
+        auto* w = waiters_head_;
+        if (w != nullptr) {
+            unpark(*w);
+        }
+        return w;
+    }
+
+    static void free_(Raw* task) noexcept {
+        DOCA_STDEXEC_TRACE_EVENT(task_free, task);
+        doca_task_free(AsTask(task));
+    }
+
+    Raw* head_ = nullptr;
+    size_t size_ = 0;
+    bool enabled_ = true;
+    waiter* waiters_head_ = nullptr;
+    waiter* waiters_tail_ = nullptr;
+};
+
+struct task_cache_stats {
+    // tasks allocated from DOCA's task pool, and taken from the cache instead
+    uint64_t allocated = 0;
+    uint64_t reused = 0;
+    // operations that found the pool exhausted and waited for a task
+    uint64_t parked = 0;
+};
+
+using write_free_list = task_free_list<doca_rdma_task_write, doca_rdma_task_write_as_task>;
+using read_free_list = task_free_list<doca_rdma_task_read, doca_rdma_task_read_as_task>;
+using send_free_list = task_free_list<doca_rdma_task_send, doca_rdma_task_send_as_task>;
+using receive_free_list = task_free_list<doca_rdma_task_receive, doca_rdma_task_receive_as_task>;
+using write_imm_free_list = task_free_list<doca_rdma_task_write_imm, doca_rdma_task_write_imm_as_task>;
+using send_imm_free_list = task_free_list<doca_rdma_task_send_imm, doca_rdma_task_send_imm_as_task>;
+
+/**
+ * @brief The task free lists of one Rdma context
+ *
+ * Steady-state operations take their task from here and hand it back on
+ * completion, so DOCA's task allocator is only touched while the cache
+ * warms up to the number of tasks in flight at once.
+ */
+class task_cache {
+public:
+    // a cached task of the list's type, or nullptr
+    template <typename List>
+    auto* take() noexcept {
+        auto* task = std::get<List>(lists_).pop();
+        if (task != nullptr) {
+            stats_.reused++;
+        }
+        return task;
+    }
+
+    template <typename List>
+    List& list() noexcept {
+        return std::get<List>(lists_);
+    }
+
+    void count_allocation() noexcept {
+        stats_.allocated++;
+    }
+
+    template <typename List>
+    void park(typename List::waiter& w) noexcept {
+        stats_.parked++;
+        std::get<List>(lists_).park(w);
+    }
+
+    // Disabling frees the cached tasks and every task released afterwards,
+    // and completes the parked operations with set_stopped; meant for
+    // stopping the context, which waits for all of its tasks.
+    void set_enabled(bool enabled) noexcept {
+        std::apply([&](auto&... lists) { (lists.set_enabled(enabled), ...); }, lists_);
+    }
+
+    [[nodiscard]]
+    task_cache_stats stats() const noexcept {
+        return stats_;
+    }
+
+private:
+    std::tuple<write_free_list, read_free_list, send_free_list, receive_free_list, write_imm_free_list,
+               send_imm_free_list>
+        lists_;
+    task_cache_stats stats_;
+};
+
+/**
+ * @brief Owns a DOCA task while an operation holds it
+ *
+ * Releasing hands the task back to the free list it came from.
+ */
+template <typename Raw, doca_task* (*AsTask)(Raw*)>
+class pooled_task {
+public:
+    using raw_type = Raw;
+    using free_list = task_free_list<Raw, AsTask>;
+
+    pooled_task() = default;
+    pooled_task(Raw* task, free_list& home) noexcept : task_(task, releaser{&home}) {}
+
+    doca_task* as_task() noexcept {
+        return AsTask(task_.get());
+    }
+
+    static doca_task* as_task(Raw* task) noexcept {
+        return AsTask(task);
+    }
+
+    Raw* get() const noexcept {
+        return task_.get();
+    }
+
+    void release() noexcept {
+        task_.reset();
+    }
+
+private:
+    struct releaser {
+        free_list* home = nullptr;
+
+        void operator()(Raw* task) const noexcept {
+            home->push(task);
+        }
+    };
+
+    std::unique_ptr<Raw, releaser> task_;
+};
+
+} // namespace doca_stdexec::rdma::task
+
+#endif // DOCA_STDEXEC_RDMA_TASK_CACHE_HPP
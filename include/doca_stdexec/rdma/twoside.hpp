@@ -3,141 +3,121 @@
 #define DOCA_STDEXEC_RDMA_TWOSIDE_HPP
 
 #include "doca_stdexec/rdma.hpp"
+#include "doca_stdexec/trace.hpp"
+#include <arpa/inet.h>
 #include <doca_pe.h>
 #include <doca_rdma.h>
-#include <stdexcept>
+#include <optional>
 #include <stdexec/execution.hpp>
 
 namespace doca_stdexec::rdma {
 
-struct rdma_send_deleter {
-  void operator()(doca_rdma_task_send *task) {
-    doca_task_free(doca_rdma_task_send_as_task(task));
-  }
-};
-
-struct RdmaSendTask {
-  using raw_type = doca_rdma_task_send;
-
-public:
-  RdmaSendTask(doca_rdma_task_send *task) : task(task) {}
-
-  RdmaSendTask(RdmaSendTask &&other) = default;
+struct RdmaSendTask
+    : task::pooled_task<doca_rdma_task_send, doca_rdma_task_send_as_task> {
+  static constexpr latency::opcode opcode = latency::opcode::send;
 
-  static RdmaSendTask allocate(doca_rdma *rdma, doca_rdma_connection *conn,
-                               doca_buf *buf) {
+  using pooled_task::pooled_task;
 
+  static doca_error_t allocate(doca_rdma *rdma, doca_rdma_connection *conn,
+                               doca_buf *buf, doca_rdma_task_send **task) {
     union doca_data user_data;
     user_data.u64 = 0;
-
-    doca_rdma_task_send *task = nullptr;
-
-    auto err =
-        doca_rdma_task_send_allocate_init(rdma, conn, buf, user_data, &task);
-    printf("allocated send task %p\n", task);
-    if (err != DOCA_SUCCESS) {
-      throw std::runtime_error("Failed to allocate send task");
-    }
-
-    return RdmaSendTask(task);
+    return doca_rdma_task_send_allocate_init(rdma, conn, buf, user_data, task);
   }
 
-  doca_task *as_task() { return doca_rdma_task_send_as_task(task.get()); }
-
-  void submit() {
-    auto err = doca_task_submit(doca_rdma_task_send_as_task(task.get()));
-    if (err != DOCA_SUCCESS) {
-      throw std::runtime_error("Failed to submit send task");
-    }
+  static void retarget(doca_rdma_task_send *task, doca_rdma_connection *conn,
+                       doca_buf *buf) {
+    doca_rdma_task_send_set_rdma_connection(task, conn);
+    doca_rdma_task_send_set_src_buf(task, buf);
   }
-
-  ~RdmaSendTask() = default;
-
-private:
-  std::unique_ptr<doca_rdma_task_send, rdma_send_deleter> task;
 };
 
 inline auto RdmaConnection::send(Buf buf) {
   auto sender = rdma::task::rdma_sender<RdmaSendTask, doca_buf *>{
-      rdma->get(), connection.get(), std::make_tuple(buf.get())};
+      rdma->get(), connection.get(), rdma->connected_loop, &rdma->tasks,
+      &rdma->bell, std::make_tuple(buf.get()), latency_probe()};
   return sender;
 }
 
-struct RdmaRecvTask {
-  using raw_type = doca_rdma_task_receive;
-
-public:
-  RdmaRecvTask(doca_rdma_task_receive *task);
+struct RdmaSendImmTask : task::pooled_task<doca_rdma_task_send_imm,
+                                            doca_rdma_task_send_imm_as_task> {
+  static constexpr latency::opcode opcode = latency::opcode::send_imm;
 
-  static RdmaRecvTask allocate(doca_rdma *rdma, doca_buf *buf) {
+  using pooled_task::pooled_task;
 
+  static doca_error_t allocate(doca_rdma *rdma, doca_rdma_connection *conn,
+                               doca_buf *buf, doca_be32_t immediate,
+                               doca_rdma_task_send_imm **task) {
     union doca_data user_data;
     user_data.u64 = 0;
-
-    doca_rdma_task_receive *task = nullptr;
-
-    auto err =
-        doca_rdma_task_receive_allocate_init(rdma, buf, user_data, &task);
-    if (err != DOCA_SUCCESS) {
-      throw std::runtime_error("Failed to allocate recv task");
-    }
-
-    return RdmaRecvTask(task);
+    return doca_rdma_task_send_imm_allocate_init(rdma, conn, buf, immediate,
+                                                 user_data, task);
   }
 
-  doca_task *as_task() { return doca_rdma_task_receive_as_task(task); }
-
-  void submit() {
-    auto err = doca_task_submit(doca_rdma_task_receive_as_task(task));
-    if (err != DOCA_SUCCESS) {
-      throw std::runtime_error("Failed to submit recv task");
-    }
+  static void retarget(doca_rdma_task_send_imm *task,
+                       doca_rdma_connection *conn, doca_buf *buf,
+                       doca_be32_t immediate) {
+    doca_rdma_task_send_imm_set_rdma_connection(task, conn);
+    doca_rdma_task_send_imm_set_src_buf(task, buf);
+    doca_rdma_task_send_imm_set_immediate_data(task, immediate);
   }
-
-  ~RdmaRecvTask();
-
-private:
-  doca_rdma_task_receive *task;
 };
 
-template <typename Receiver> struct RdmaRecvOperation {
-  static void on_completion(doca_rdma_task_receive *task, doca_data user_data,
-                            doca_data ctx_data) {
-    auto *op = static_cast<RdmaRecvOperation *>(user_data.ptr);
-    op->receiver.set_value();
-  }
-
-  static void on_error(doca_rdma_task_receive *task, doca_data user_data,
-                       doca_data ctx_data) {
-    auto *op = static_cast<RdmaRecvOperation *>(user_data.ptr);
-    op->receiver.set_error();
-  }
-
-  void start() noexcept { task.submit(); }
+inline auto RdmaConnection::send_imm(Buf buf, uint32_t immediate) {
+  auto sender = rdma::task::rdma_sender<RdmaSendImmTask, doca_buf *,
+                                        doca_be32_t>{
+      rdma->get(), connection.get(), rdma->connected_loop, &rdma->tasks,
+      &rdma->bell, std::make_tuple(buf.get(), htonl(immediate)),
+      latency_probe()};
+  return sender;
+}
 
-  Receiver receiver;
-  RdmaRecvTask task;
+// What a receive matched: a plain send, or a send or write with immediate,
+// whose immediate is in host byte order
+struct receive_result {
+  doca_rdma_opcode opcode;
+  std::optional<uint32_t> immediate;
 };
 
-// TODO: return the connection
-struct RdmaRecvSender {
-  using sender_concept = stdexec::sender_t;
+struct RdmaRecvTask : task::pooled_task<doca_rdma_task_receive,
+                                         doca_rdma_task_receive_as_task> {
+  static constexpr latency::opcode opcode = latency::opcode::recv;
+
+  using pooled_task::pooled_task;
 
-  using completion_signatures =
-      stdexec::completion_signatures<stdexec::set_value_t,
-                                     stdexec::set_error_t(doca_error_t)>;
+  // a receive is posted on the context and matched with whichever
+  // connection sends next, `conn` is unused
+  static doca_error_t allocate(doca_rdma *rdma, doca_rdma_connection *conn,
+                               doca_buf *buf, doca_rdma_task_receive **task) {
+    union doca_data user_data;
+    user_data.u64 = 0;
+    return doca_rdma_task_receive_allocate_init(rdma, buf, user_data, task);
+  }
 
-  auto connect(stdexec::receiver auto rcvr) {
-    return RdmaRecvOperation<decltype(rcvr)>{std::move(rcvr), std::move(task)};
+  static void retarget(doca_rdma_task_receive *task,
+                       doca_rdma_connection *conn,
+                       doca_buf *buf) {
+    doca_rdma_task_receive_set_dst_buf(task, buf);
   }
 
-  RdmaRecvTask task;
+  static receive_result result(doca_rdma_task_receive *task) {
+    auto opcode = doca_rdma_task_receive_get_result_opcode(task);
+    if (opcode == DOCA_RDMA_OPCODE_RECV_SEND) {
+      return {opcode, std::nullopt};
+    }
+    return {opcode,
+            ntohl(doca_rdma_task_receive_get_result_immediate_data(task))};
+  }
 };
 
+// Completes with a receive_result once a message from any connection of the
+// context landed in `buf`; its data length is extended by the received
+// bytes. A write with immediate lands nothing in `buf`.
 inline auto Rdma::recv(Buf &buf) {
-  auto task = RdmaRecvTask::allocate(rdma.get(), buf.get());
-  // auto sender = rdma::task::rdma_sender<RdmaRecvTask>{std::move(task)};
-  return stdexec::just(1);
+  auto sender = rdma::task::rdma_sender<RdmaRecvTask, doca_buf *>{
+      rdma.get(), nullptr, connected_loop, &tasks, &bell,
+      std::make_tuple(buf.get()), latency::probe{&latency_histograms, nullptr}};
+  return sender;
 }
 
 } // namespace doca_stdexec::rdma
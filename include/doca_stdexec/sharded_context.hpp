@@ -0,0 +1,210 @@
+#pragma once
+#ifndef DOCA_STDEXEC_SHARDED_CONTEXT_HPP
+#define DOCA_STDEXEC_SHARDED_CONTEXT_HPP
+
+#include "doca_stdexec/common/tcp.hpp"
+#include "doca_stdexec/device.hpp"
+#include "doca_stdexec/progress_engine.hpp"
+#include "doca_stdexec/rdma.hpp"
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <stdexec/execution.hpp>
+#include <vector>
+
+namespace doca_stdexec {
+
+enum class shard_placement {
+    round_robin,
+    // shard with the fewest live connections
+    least_loaded,
+};
+
+struct sharded_context_options {
+    size_t num_shards = 1;
+    // shard i is pinned to cpus[i % cpus.size()], empty leaves them unpinned
+    std::vector<int> cpus;
+    // when cpus is empty, pin to CPUs on the NIC's socket (isolated ones
+    // first) and prefer the NIC's NUMA node for PE thread allocations
+    bool device_local = false;
+    // SCHED_FIFO priority of the PE threads, 0 keeps the default policy
+    int realtime_priority = 0;
+    shard_placement placement = shard_placement::round_robin;
+    loop::run_loop_options loop_options{};
+    // applied to every shard's Rdma before it is started, e.g. to set the gid index
+    std::function<void(rdma::Rdma&)> configure_rdma;
+};
+
+/**
+ * @brief A connection bound to the shard that owns its Rdma context
+ *
+ * Work on the connection must be scheduled on `scheduler`; its completions
+ * are delivered by the same PE thread, so a chain started there never
+ * crosses threads.
+ */
+struct shard_connection {
+    struct load_release {
+        void operator()(std::atomic<size_t>* load) const noexcept {
+            load->fetch_sub(1, std::memory_order_relaxed);
+        }
+    };
+
+    rdma::RdmaConnection connection;
+    run_loop::scheduler scheduler;
+    size_t shard;
+    std::unique_ptr<std::atomic<size_t>, load_release> lease;
+};
+
+/**
+ * @brief N pinned PE threads, each with its own Rdma context on one device
+ *
+ * New connections are placed on a shard by the configured policy and stay
+ * there for their whole lifetime.
+ */
+class sharded_pe_context {
+    struct shard {
+        doca_pe_context context;
+        std::shared_ptr<rdma::Rdma> rdma;
+        // live connections placed on this shard
+        alignas(cache_line_size) std::atomic<size_t> connections{0};
+
+        shard(loop::run_loop_options loop_options, pe_thread_options thread_options)
+            : context(ProgressEngine{}, loop_options, thread_options) {}
+    };
+
+public:
+    sharded_pe_context(std::shared_ptr<Device> device, sharded_context_options options)
+        : device_(std::move(device)), placement_(options.placement) {
+        if (options.num_shards == 0) {
+            check_error(DOCA_ERROR_INVALID_VALUE, "Sharded context needs at least one shard");
+        }
+
+        shards_.reserve(options.num_shards);
+        for (size_t i = 0; i < options.num_shards; i++) {
+            pe_thread_options thread_options{.realtime_priority = options.realtime_priority};
+            if (!options.cpus.empty()) {
+                thread_options.cpu = options.cpus[i % options.cpus.size()];
+            } else if (options.device_local) {
+                thread_options = pe_thread_options::near(*device_, i, options.realtime_priority);
+            }
+
+            auto& s = *shards_.emplace_back(std::make_unique<shard>(options.loop_options, thread_options));
+            s.rdma = rdma::Rdma::open_from_dev(device_);
+            if (options.configure_rdma) {
+                options.configure_rdma(*s.rdma);
+            }
+
+            stdexec::sync_wait(stdexec::schedule(s.context.get_scheduler()) | stdexec::then([&s] {
+                                   s.context.connect_ctx(s.rdma);
+                                   s.rdma->start();
+                               }));
+        }
+    }
+
+    sharded_pe_context(const sharded_pe_context&) = delete;
+    sharded_pe_context& operator=(const sharded_pe_context&) = delete;
+
+    ~sharded_pe_context() {
+        for (auto& s : shards_) {
+            stdexec::sync_wait(stdexec::schedule(s->context.get_scheduler()) |
+                               stdexec::then([&s] { s->rdma->stop(); }));
+        }
+    }
+
+    [[nodiscard]]
+    size_t num_shards() const noexcept {
+        return shards_.size();
+    }
+
+    auto get_scheduler(size_t shard, priority priority = priority::normal) noexcept {
+        return shards_[shard]->context.get_scheduler(priority);
+    }
+
+    std::shared_ptr<rdma::Rdma> get_rdma(size_t shard) const noexcept {
+        return shards_[shard]->rdma;
+    }
+
+    [[nodiscard]]
+    loop::run_loop_stats stats(size_t shard) const noexcept {
+        return shards_[shard]->context.stats();
+    }
+
+    [[nodiscard]]
+    size_t get_load(size_t shard) const noexcept {
+        return shards_[shard]->connections.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Establish a connection on an explicit shard
+     *
+     * Exchanges the connection descriptors over `socket` before returning,
+     * on the calling thread, which must not be a PE thread of this context;
+     * the sender then only connects on the shard.
+     */
+    auto connect_on(size_t index, tcp::tcp_socket& socket) {
+        auto& s = *shards_[index];
+        s.connections.fetch_add(1, std::memory_order_relaxed);
+        auto lease = std::unique_ptr<std::atomic<size_t>, shard_connection::load_release>(&s.connections);
+
+        // connection setup is control plane work, it must not queue behind
+        // the data path of the shard's existing connections
+        auto control = s.context.get_scheduler(priority::high);
+
+        // exporting touches the context, which belongs to the shard's PE thread
+        auto [exported] =
+            stdexec::sync_wait(stdexec::schedule(control) | stdexec::then([&s] { return s.rdma->export_ctx(); }))
+                .value();
+        auto& [exported_ctx, connection] = exported;
+        // the exchange waits for the peer, a network round trip the shard's
+        // completions must not wait behind
+        socket.send_dynamic(exported_ctx);
+        auto received_ctx = socket.receive_dynamic();
+
+        return stdexec::schedule(control) |
+               stdexec::let_value([sender = rdma::rdma_connection_sender{.connection = std::move(connection),
+                                                                         .ctx = std::move(received_ctx)}]() mutable {
+                   return std::move(sender);
+               }) |
+               stdexec::then([&s, index, lease = std::move(lease)](rdma::RdmaConnection connection) mutable {
+                   return shard_connection{
+                       .connection = std::move(connection),
+                       .scheduler = s.context.get_scheduler(),
+                       .shard = index,
+                       .lease = std::move(lease),
+                   };
+               });
+    }
+
+    /**
+     * @brief Establish a connection on the shard chosen by the placement policy
+     * @return Sender of shard_connection; the descriptor exchange has already
+     *         happened on the calling thread, like connect_on
+     */
+    auto connect(tcp::tcp_socket& socket) {
+        return connect_on(pick_shard_(), socket);
+    }
+
+private:
+    size_t pick_shard_() noexcept {
+        if (placement_ == shard_placement::least_loaded) {
+            size_t best = 0;
+            for (size_t i = 1; i < shards_.size(); i++) {
+                if (get_load(i) < get_load(best)) {
+                    best = i;
+                }
+            }
+            return best;
+        }
+        return next_.fetch_add(1, std::memory_order_relaxed) % shards_.size();
+    }
+
+    std::shared_ptr<Device> device_;
+    shard_placement placement_;
+    std::vector<std::unique_ptr<shard>> shards_;
+    std::atomic<size_t> next_{0};
+};
+
+} // namespace doca_stdexec
+
+#endif // DOCA_STDEXEC_SHARDED_CONTEXT_HPP
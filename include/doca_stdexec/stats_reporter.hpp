@@ -0,0 +1,117 @@
+#pragma once
+#ifndef DOCA_STDEXEC_STATS_REPORTER_HPP
+#define DOCA_STDEXEC_STATS_REPORTER_HPP
+
+#include "doca_stdexec/progress_engine.hpp"
+#include "doca_stdexec/sharded_context.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <functional>
+#include <mutex>
+#include <stop_token>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace doca_stdexec {
+
+/**
+ * @brief Periodically snapshots the stats of a set of run loops from a
+ *        thread of its own and hands each interval's activity to a sink
+ *
+ * Reading the counters never writes to the PE threads' cache lines, so the
+ * PE threads pay nothing beyond the counter updates they always do.
+ *
+ *   stats_reporter reporter{std::chrono::seconds(1)};
+ *   reporter.watch("pe0", context);
+ */
+class stats_reporter {
+public:
+    using source = std::function<loop::run_loop_stats()>;
+    // called on the reporter thread with the activity of one interval
+    using sink = std::function<void(const std::string& name, const loop::run_loop_stats& window,
+                                    std::chrono::nanoseconds interval)>;
+
+    explicit stats_reporter(std::chrono::nanoseconds interval, sink sink = print_to(stdout))
+        : interval_(interval), sink_(std::move(sink)), thread_([this](std::stop_token stop) { run_(stop); }) {}
+
+    stats_reporter(const stats_reporter&) = delete;
+    stats_reporter& operator=(const stats_reporter&) = delete;
+
+    // `context` must outlive the reporter
+    void watch(std::string name, const doca_pe_context& context) {
+        watch(std::move(name), [&context] { return context.stats(); });
+    }
+
+    // one source per shard, named "<name>/<shard>"
+    void watch(const std::string& name, const sharded_pe_context& context) {
+        for (size_t shard = 0; shard < context.num_shards(); shard++) {
+            watch(name + "/" + std::to_string(shard), [&context, shard] { return context.stats(shard); });
+        }
+    }
+
+    void watch(std::string name, source source) {
+        auto initial = source();
+        std::lock_guard lock(mutex_);
+        watched_.push_back(watched{std::move(name), std::move(source), initial});
+    }
+
+    /**
+     * @brief Sink writing one line per loop and interval
+     */
+    static sink print_to(FILE* out) {
+        return [out](const std::string& name, const loop::run_loop_stats& window, std::chrono::nanoseconds interval) {
+            auto seconds = std::chrono::duration<double>(interval).count();
+            auto polls = window.productive_polls + window.empty_polls;
+            fprintf(out,
+                    "%s: util %5.1f%% tasks %.0f/s doca %.0f/s in-flight %llu (max %llu) productive polls %5.1f%% "
+                    "queue max %llu batch max %llu\n",
+                    name.c_str(), window.utilization() * 100,
+                    static_cast<double>(window.tasks_executed + window.tasks_inlined) / seconds,
+                    static_cast<double>(window.doca_tasks_completed) / seconds,
+                    static_cast<unsigned long long>(window.doca_tasks_in_flight),
+                    static_cast<unsigned long long>(window.doca_tasks_in_flight_high_water),
+                    polls > 0 ? 100.0 * static_cast<double>(window.productive_polls) / static_cast<double>(polls) : 0.0,
+                    static_cast<unsigned long long>(window.local_queue_high_water),
+                    static_cast<unsigned long long>(window.remote_batch_high_water));
+            fflush(out);
+        };
+    }
+
+private:
+    struct watched {
+        std::string name;
+        source read;
+        loop::run_loop_stats last;
+    };
+
+    void run_(std::stop_token stop) {
+        auto last = std::chrono::steady_clock::now();
+        auto next = last + interval_;
+        std::unique_lock lock(mutex_);
+        while (!wakeup_.wait_until(lock, stop, next, [] { return false; }) && !stop.stop_requested()) {
+            auto now = std::chrono::steady_clock::now();
+            for (auto& w : watched_) {
+                auto current = w.read();
+                sink_(w.name, current.since(w.last), now - last);
+                w.last = current;
+            }
+            last = now;
+            next += interval_;
+        }
+    }
+
+    std::chrono::nanoseconds interval_;
+    sink sink_;
+    std::mutex mutex_;
+    std::condition_variable_any wakeup_;
+    std::vector<watched> watched_;
+    // last, so it starts after and is joined before everything it uses
+    std::jthread thread_;
+};
+
+} // namespace doca_stdexec
+
+#endif // DOCA_STDEXEC_STATS_REPORTER_HPP
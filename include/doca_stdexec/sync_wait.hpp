@@ -0,0 +1,152 @@
+#pragma once
+#ifndef DOCA_STDEXEC_SYNC_WAIT_HPP
+#define DOCA_STDEXEC_SYNC_WAIT_HPP
+
+#include "doca_stdexec/common.hpp"
+#include "doca_stdexec/progress_engine.hpp"
+#include <atomic>
+#include <exception>
+#include <optional>
+#include <stdexec/execution.hpp>
+#include <system_error>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace doca_stdexec {
+
+namespace detail {
+
+template <typename... Values>
+using decayed_tuple = std::tuple<std::decay_t<Values>...>;
+
+// like stdexec::sync_wait, only senders with a single value completion
+template <typename Tuple>
+using only_value_completion = Tuple;
+
+struct sync_wait_env {
+    run_loop* loop_;
+
+    auto query(stdexec::get_scheduler_t) const noexcept {
+        return loop_->get_scheduler();
+    }
+
+    auto query(stdexec::get_delegation_scheduler_t) const noexcept {
+        return loop_->get_scheduler();
+    }
+};
+
+template <typename Sender>
+using sync_wait_values_t =
+    stdexec::value_types_of_t<Sender, sync_wait_env, decayed_tuple, only_value_completion>;
+
+template <typename Values>
+struct sync_wait_state {
+    run_loop* loop_;
+    std::optional<Values> values_;
+    std::exception_ptr error_;
+    std::atomic<bool> done_ = false;
+
+    explicit sync_wait_state(run_loop* loop) noexcept : loop_(loop) {}
+
+    void finish() noexcept {
+        // once done_ is set the caller may return and destroy this state,
+        // so everything needed afterwards is read first
+        auto* loop = loop_;
+        bool remote = !loop->on_loop_thread();
+        done_.store(true, std::memory_order_seq_cst);
+        // the caller may be blocked in the loop waiting for this
+        if (remote) {
+            loop->wake();
+        }
+    }
+};
+
+template <typename Values>
+struct sync_wait_receiver {
+    using receiver_concept = stdexec::receiver_t;
+
+    sync_wait_state<Values>* state_;
+
+    template <typename... Args>
+    void set_value(Args&&... args) noexcept {
+        try {
+            state_->values_.emplace(static_cast<Args&&>(args)...);
+        } catch (...) {
+            state_->error_ = std::current_exception();
+        }
+        state_->finish();
+    }
+
+    template <typename Error>
+    void set_error(Error&& err) noexcept {
+        if constexpr (std::same_as<std::decay_t<Error>, std::exception_ptr>) {
+            state_->error_ = static_cast<Error&&>(err);
+        } else if constexpr (std::same_as<std::decay_t<Error>, doca_error_t>) {
+            state_->error_ = std::make_exception_ptr(doca_failure(err));
+        } else if constexpr (std::same_as<std::decay_t<Error>, std::error_code>) {
+            state_->error_ = std::make_exception_ptr(std::system_error(err));
+        } else {
+            state_->error_ = std::make_exception_ptr(static_cast<Error&&>(err));
+        }
+        state_->finish();
+    }
+
+    void set_stopped() noexcept {
+        state_->finish();
+    }
+
+    [[nodiscard]]
+    auto get_env() const noexcept -> sync_wait_env {
+        return sync_wait_env{state_->loop_};
+    }
+};
+
+} // namespace detail
+
+/**
+ * @brief stdexec::sync_wait that drives `loop` on the calling thread
+ *
+ * Starts `sndr` and runs passes of the loop (tasks, PE completions, timers)
+ * on the caller's thread until it completes, in the spirit of stdexec's
+ * run_loop. Without a dedicated PE thread a round trip saves the two thread
+ * hops of schedule() onto the PE and of waking the caller back up:
+ *
+ *   run_loop loop{ProgressEngine{}};
+ *   loop.connect_ctx(rdma);
+ *   doca_stdexec::sync_wait(loop, connection.write(src, dst));
+ *
+ * The loop must not be run by any other thread, and only from one
+ * sync_wait at a time. Between calls nothing polls the PE, so completions
+ * and scheduled tasks wait for the next call. Blocks in the loop's
+ * notification fd under progress_mode::adaptive, as run() does.
+ *
+ * @return The values of the sender, nullopt if it stopped
+ * @throws The error of the sender, with doca_error_t as doca_failure
+ */
+template <stdexec::sender Sender>
+auto sync_wait(run_loop& loop, Sender&& sndr) -> std::optional<detail::sync_wait_values_t<Sender>> {
+    using values_t = detail::sync_wait_values_t<Sender>;
+
+    detail::sync_wait_state<values_t> state{&loop};
+    auto op = stdexec::connect(static_cast<Sender&&>(sndr), detail::sync_wait_receiver<values_t>{&state});
+
+    // started from inside the loop so that it sees the caller as its PE thread
+    bool started = false;
+    loop.run_until([&] {
+        if (!started) {
+            started = true;
+            stdexec::start(op);
+        }
+        return state.done_.load(std::memory_order_acquire);
+    });
+
+    if (state.error_) {
+        std::rethrow_exception(state.error_);
+    }
+    return std::move(state.values_);
+}
+
+} // namespace doca_stdexec
+
+#endif // DOCA_STDEXEC_SYNC_WAIT_HPP
@@ -0,0 +1,210 @@
+#pragma once
+#ifndef DOCA_STDEXEC_TIMEOUT_HPP
+#define DOCA_STDEXEC_TIMEOUT_HPP
+
+#include "doca_stdexec/operation.hpp"
+#include <atomic>
+#include <chrono>
+#include <concepts>
+#include <doca_error.h>
+#include <memory>
+#include <optional>
+#include <stdexec/execution.hpp>
+#include <type_traits>
+#include <utility>
+
+namespace doca_stdexec {
+
+namespace detail {
+
+// What the raced sender and the timer see of the environment: only the
+// timeout's stop token, as both may outlive the timeout's receiver.
+struct timeout_env {
+    stdexec::inplace_stop_token token;
+
+    [[nodiscard]]
+    auto query(stdexec::get_stop_token_t) const noexcept -> stdexec::inplace_stop_token {
+        return token;
+    }
+};
+
+/**
+ * @brief The raced sender and the timer, freed by whichever of them
+ *        completes last
+ *
+ * The first to complete completes the timeout's receiver and asks the other
+ * to stop; the other then runs to its end on this state alone.
+ */
+template <class Sender, class Scheduler, class Receiver>
+struct timeout_state : immovable {
+    using stop_token_t = stdexec::stop_token_of_t<stdexec::env_of_t<Receiver>>;
+
+    struct forward_stop {
+        timeout_state* self;
+
+        void operator()() const noexcept {
+            self->stop_source_.request_stop();
+        }
+    };
+
+    struct child_receiver {
+        using receiver_concept = stdexec::receiver_t;
+
+        timeout_state* self;
+
+        template <class... Values>
+        void set_value(Values&&... values) noexcept {
+            self->template complete_<stdexec::set_value_t>(static_cast<Values&&>(values)...);
+        }
+
+        template <class Error>
+        void set_error(Error&& error) noexcept {
+            self->template complete_<stdexec::set_error_t>(static_cast<Error&&>(error));
+        }
+
+        void set_stopped() noexcept {
+            self->template complete_<stdexec::set_stopped_t>();
+        }
+
+        [[nodiscard]]
+        auto get_env() const noexcept -> timeout_env {
+            return {self->stop_source_.get_token()};
+        }
+    };
+
+    struct timer_receiver {
+        using receiver_concept = stdexec::receiver_t;
+
+        timeout_state* self;
+
+        void set_value() noexcept {
+            self->template complete_<stdexec::set_error_t>(DOCA_ERROR_TIME_OUT);
+        }
+
+        template <class Error>
+        void set_error(Error&& error) noexcept {
+            self->template complete_<stdexec::set_error_t>(static_cast<Error&&>(error));
+        }
+
+        void set_stopped() noexcept {
+            self->template complete_<stdexec::set_stopped_t>();
+        }
+
+        [[nodiscard]]
+        auto get_env() const noexcept -> timeout_env {
+            return {self->stop_source_.get_token()};
+        }
+    };
+
+    using timer_sender =
+        decltype(std::declval<Scheduler&>().schedule_after(std::declval<std::chrono::steady_clock::duration>()));
+
+    timeout_state(Sender&& sndr, Scheduler& sched, std::chrono::steady_clock::duration duration, Receiver&& rcvr)
+        : receiver_(static_cast<Receiver&&>(rcvr)),
+          child_op_(stdexec::connect(static_cast<Sender&&>(sndr), child_receiver{this})),
+          timer_op_(stdexec::connect(sched.schedule_after(duration), timer_receiver{this})) {}
+
+    void start() noexcept {
+        if constexpr (!stdexec::unstoppable_token<stop_token_t>) {
+            on_stop_.emplace(stdexec::get_stop_token(stdexec::get_env(receiver_)), forward_stop{this});
+        }
+        // either may complete, and the state be freed, within its start
+        stdexec::start(timer_op_);
+        stdexec::start(child_op_);
+    }
+
+private:
+    template <class Tag, class... Args>
+    void complete_(Args&&... args) noexcept {
+        if (!done_.exchange(true, std::memory_order_acq_rel)) {
+            stop_source_.request_stop();
+            on_stop_.reset();
+            if constexpr (std::same_as<Tag, stdexec::set_value_t>) {
+                stdexec::set_value(static_cast<Receiver&&>(receiver_), static_cast<Args&&>(args)...);
+            } else if constexpr (std::same_as<Tag, stdexec::set_error_t>) {
+                stdexec::set_error(static_cast<Receiver&&>(receiver_), static_cast<Args&&>(args)...);
+            } else {
+                stdexec::set_stopped(static_cast<Receiver&&>(receiver_));
+            }
+        }
+        if (refs_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            delete this;
+        }
+    }
+
+    stdexec::inplace_stop_source stop_source_;
+    Receiver receiver_;
+    std::atomic<bool> done_ = false;
+    // the raced sender and the timer
+    std::atomic<unsigned> refs_ = 2;
+    std::optional<stdexec::stop_callback_for_t<stop_token_t, forward_stop>> on_stop_;
+    stdexec::connect_result_t<Sender, child_receiver> child_op_;
+    stdexec::connect_result_t<timer_sender, timer_receiver> timer_op_;
+};
+
+template <class Sender, class Scheduler, class Receiver>
+struct timeout_operation : immovable {
+    using state = timeout_state<Sender, Scheduler, Receiver>;
+
+    timeout_operation(Sender&& sndr, Scheduler& sched, std::chrono::steady_clock::duration duration, Receiver&& rcvr)
+        : state_(std::make_unique<state>(static_cast<Sender&&>(sndr), sched, duration, static_cast<Receiver&&>(rcvr))) {
+    }
+
+    // from here on the state frees itself
+    void start() & noexcept {
+        state_.release()->start();
+    }
+
+private:
+    std::unique_ptr<state> state_;
+};
+
+template <class Sender, class Scheduler>
+struct timeout_sender {
+    using sender_concept = stdexec::sender_t;
+
+    template <class... Env>
+    friend auto get_completion_signatures(const timeout_sender&, Env&&...)
+        -> stdexec::transform_completion_signatures_of<
+            Sender, timeout_env,
+            stdexec::completion_signatures<stdexec::set_error_t(doca_error_t), stdexec::set_stopped_t()>> {
+        return {};
+    }
+
+    template <class Receiver>
+    auto connect(Receiver rcvr) && -> timeout_operation<Sender, Scheduler, Receiver> {
+        return {static_cast<Sender&&>(sndr), sched, duration, static_cast<Receiver&&>(rcvr)};
+    }
+
+    Sender sndr;
+    Scheduler sched;
+    std::chrono::steady_clock::duration duration;
+};
+
+} // namespace detail
+
+/**
+ * @brief Fail `sndr` with DOCA_ERROR_TIME_OUT unless it completes within `duration`
+ *
+ * Races the sender against a timer armed on `sched`, a run loop scheduler,
+ * when the combined sender is started. Whichever completes first decides
+ * the result, and the other one is asked to stop:
+ *
+ *   stdexec::sync_wait(timeout(context.get_scheduler(), connection.write(src, dst), 100ms));
+ *
+ * The timeout completes right away and does not wait for the loser, which
+ * finishes on a state of its own. DOCA cannot abort a submitted task, so a
+ * timed-out RDMA operation still runs until the NIC reports it, and its
+ * buffers must stay registered and alive until then. The raced sender only
+ * sees the timeout's stop token in its environment.
+ */
+template <typename Scheduler, stdexec::sender Sender, typename Rep, typename Period>
+auto timeout(Scheduler sched, Sender&& sndr, std::chrono::duration<Rep, Period> duration) {
+    return detail::timeout_sender<std::decay_t<Sender>, Scheduler>{
+        static_cast<Sender&&>(sndr), std::move(sched),
+        std::chrono::ceil<std::chrono::steady_clock::duration>(duration)};
+}
+
+} // namespace doca_stdexec
+
+#endif // DOCA_STDEXEC_TIMEOUT_HPP
@@ -0,0 +1,223 @@
+#pragma once
+#ifndef DOCA_STDEXEC_TOPOLOGY_HPP
+#define DOCA_STDEXEC_TOPOLOGY_HPP
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <linux/mempolicy.h>
+#include <new>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <system_error>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+namespace doca_stdexec::topology {
+
+/**
+ * @brief Parse a kernel CPU or node list such as "0-3,8,10-11"
+ */
+inline std::vector<int> parse_list(std::string_view list) {
+    std::vector<int> result;
+    while (!list.empty()) {
+        auto comma = list.find(',');
+        auto range = list.substr(0, comma);
+        list = comma == std::string_view::npos ? std::string_view{} : list.substr(comma + 1);
+
+        while (!range.empty() && (range.back() == '\n' || range.back() == ' ')) {
+            range.remove_suffix(1);
+        }
+        if (range.empty()) {
+            continue;
+        }
+
+        int first = 0;
+        int last = 0;
+        auto dash = range.find('-');
+        std::from_chars(range.data(), range.data() + std::min(dash, range.size()), first);
+        last = first;
+        if (dash != std::string_view::npos) {
+            std::from_chars(range.data() + dash + 1, range.data() + range.size(), last);
+        }
+        for (int i = first; i <= last; i++) {
+            result.push_back(i);
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Read the first line of a sysfs file, empty if it cannot be read
+ */
+inline std::string read_sysfs(const std::string& path) {
+    std::ifstream file(path);
+    std::string line;
+    std::getline(file, line);
+    return line;
+}
+
+/**
+ * @brief NUMA node of a PCI device, -1 if unknown or the host is not NUMA
+ * @param pci_addr Address in domain:bus:device.function form
+ */
+inline int pci_numa_node(std::string_view pci_addr) {
+    auto value = read_sysfs("/sys/bus/pci/devices/" + std::string(pci_addr) + "/numa_node");
+    int node = -1;
+    std::from_chars(value.data(), value.data() + value.size(), node);
+    return node;
+}
+
+/**
+ * @brief CPUs attached to the same socket as a PCI device
+ */
+inline std::vector<int> pci_local_cpus(std::string_view pci_addr) {
+    return parse_list(read_sysfs("/sys/bus/pci/devices/" + std::string(pci_addr) + "/local_cpulist"));
+}
+
+inline std::vector<int> online_nodes() {
+    return parse_list(read_sysfs("/sys/devices/system/node/online"));
+}
+
+inline std::vector<int> node_cpus(int node) {
+    return parse_list(read_sysfs("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist"));
+}
+
+/**
+ * @brief CPUs removed from the scheduler with isolcpus=
+ */
+inline std::vector<int> isolated_cpus() {
+    return parse_list(read_sysfs("/sys/devices/system/cpu/isolated"));
+}
+
+/**
+ * @brief Order `cpus` so that isolated CPUs come first
+ */
+inline std::vector<int> prefer_isolated(std::vector<int> cpus) {
+    auto isolated = isolated_cpus();
+    std::ranges::stable_partition(cpus, [&](int cpu) { return std::ranges::find(isolated, cpu) != isolated.end(); });
+    return cpus;
+}
+
+inline unsigned long node_mask(int node) {
+    if (node >= static_cast<int>(sizeof(unsigned long) * 8)) {
+        throw std::invalid_argument("NUMA node out of range");
+    }
+    return 1UL << node;
+}
+
+/**
+ * @brief Bind the calling thread's future allocations to a NUMA node
+ */
+inline void set_thread_memory_node(int node) {
+    if (node < 0) {
+        return;
+    }
+    unsigned long mask = node_mask(node);
+    if (syscall(SYS_set_mempolicy, MPOL_PREFERRED, &mask, sizeof(mask) * 8) != 0) {
+        throw std::system_error(errno, std::system_category(), "Failed to set thread memory policy");
+    }
+}
+
+/**
+ * @brief Page-aligned anonymous memory bound to one NUMA node
+ *
+ * Meant as the backing store of an MMap, so the NIC's DMA does not cross
+ * the socket interconnect:
+ *
+ *   auto memory = topology::node_buffer<uint8_t>(size, device->numa_node());
+ *   MMap<uint8_t> mmap{memory.span()};
+ *
+ * Pages are faulted in up front so registration does not pay for them.
+ *
+ * @tparam T Element type
+ */
+template <typename T>
+class node_buffer {
+public:
+    node_buffer() = default;
+
+    /**
+     * @param count Number of elements
+     * @param node NUMA node, -1 for the default policy
+     */
+    node_buffer(size_t count, int node) : size_(count * sizeof(T)) {
+        void* addr = mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (addr == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+        data_ = static_cast<T*>(addr);
+        count_ = count;
+
+        if (node >= 0) {
+            unsigned long mask = node_mask(node);
+            if (syscall(SYS_mbind, addr, size_, MPOL_BIND, &mask, sizeof(mask) * 8, 0) != 0) {
+                auto error = errno;
+                munmap(addr, size_);
+                throw std::system_error(error, std::system_category(), "Failed to bind memory to numa node");
+            }
+        }
+
+        auto page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        for (size_t offset = 0; offset < size_; offset += page_size) {
+            static_cast<volatile std::byte*>(addr)[offset] = std::byte{0};
+        }
+    }
+
+    node_buffer(const node_buffer&) = delete;
+    node_buffer& operator=(const node_buffer&) = delete;
+
+    node_buffer(node_buffer&& other) noexcept
+        : data_(std::exchange(other.data_, nullptr)), count_(std::exchange(other.count_, 0)),
+          size_(std::exchange(other.size_, 0)) {}
+
+    node_buffer& operator=(node_buffer&& other) noexcept {
+        if (this != &other) {
+            release_();
+            data_ = std::exchange(other.data_, nullptr);
+            count_ = std::exchange(other.count_, 0);
+            size_ = std::exchange(other.size_, 0);
+        }
+        return *this;
+    }
+
+    ~node_buffer() {
+        release_();
+    }
+
+    T* data() const noexcept {
+        return data_;
+    }
+
+    size_t size() const noexcept {
+        return count_;
+    }
+
+    std::span<T> span() const noexcept {
+        return {data_, count_};
+    }
+
+private:
+    void release_() noexcept {
+        if (data_ != nullptr) {
+            munmap(data_, size_);
+            data_ = nullptr;
+        }
+    }
+
+    T* data_ = nullptr;
+    size_t count_ = 0;
+    size_t size_ = 0;
+};
+
+} // namespace doca_stdexec::topology
+
+#endif // DOCA_STDEXEC_TOPOLOGY_HPP
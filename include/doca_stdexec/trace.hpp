@@ -0,0 +1,360 @@
+#pragma once
+#ifndef DOCA_STDEXEC_TRACE_HPP
+#define DOCA_STDEXEC_TRACE_HPP
+
+#include "doca_stdexec/common/cycle_clock.hpp"
+#include "doca_stdexec/common/mpsc_queue.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+/**
+ * Operation lifecycle tracing.
+ *
+ * Build with -DDOCA_STDEXEC_TRACE (meson -Dtrace=true, xmake f --trace=y)
+ * to record events; otherwise DOCA_STDEXEC_TRACE_EVENT expands to nothing
+ * and its arguments are not evaluated.
+ *
+ * Every thread appends fixed-size records to its own ring buffer, with a
+ * raw cycle counter as timestamp and no locks or syscalls. Rings keep the
+ * newest DOCA_STDEXEC_TRACE_RING_SIZE records and outlive their threads, so
+ * a trace can be written at shutdown:
+ *
+ *   doca_stdexec::trace::write_chrome_trace("trace.json");
+ *
+ * and opened in ui.perfetto.dev or chrome://tracing.
+ */
+#ifdef DOCA_STDEXEC_TRACE
+#define DOCA_STDEXEC_TRACE_EVENT(kind, ...)                                                                            \
+    ::doca_stdexec::trace::emit(::doca_stdexec::trace::event::kind __VA_OPT__(, ) __VA_ARGS__)
+#else
+#define DOCA_STDEXEC_TRACE_EVENT(kind, ...) ((void)0)
+#endif
+
+#ifndef DOCA_STDEXEC_TRACE_RING_SIZE
+#define DOCA_STDEXEC_TRACE_RING_SIZE (1U << 16)
+#endif
+
+namespace doca_stdexec::trace {
+
+#ifdef DOCA_STDEXEC_TRACE
+inline constexpr bool enabled = true;
+#else
+inline constexpr bool enabled = false;
+#endif
+
+enum class event : uint8_t {
+    // run loop; object is the task
+    queue_push,   // arg: 0 local, 1 remote, 2 stealable
+    queue_splice, // arg: tasks taken from the remote queue
+    task_run_begin,
+    task_run_end,
+
+    // DOCA tasks; object is the task or, from submit on, the operation
+    task_allocate, // arg: connection
+    task_reuse,    // arg: connection
+    task_free,
+    task_submit,
+    task_complete, // arg: doca_error_t
+    task_stopped,
+    receiver_begin,
+    receiver_end,
+
+    // buffers; object is the doca_buf
+    buf_lookup,  // arg: length
+    buf_release, // arg: remaining refcount
+
+    // connections; object is the doca_rdma_connection
+    connection_connect,
+    connection_request,
+    connection_established,
+    connection_failure,
+    connection_disconnected,
+
+    // contexts; object is the doca_ctx
+    context_state_changed, // arg: new doca_ctx_states
+};
+
+struct record {
+    uint64_t timestamp;
+    const void* object;
+    uint64_t arg;
+    event kind;
+};
+
+inline uint64_t timestamp() noexcept {
+    return cycle_clock::now();
+}
+
+/**
+ * @brief Single-writer ring of trace records, overwriting the oldest
+ */
+class ring {
+public:
+    static constexpr size_t capacity = DOCA_STDEXEC_TRACE_RING_SIZE;
+    static_assert((capacity & (capacity - 1)) == 0, "trace ring size must be a power of two");
+
+    ring(pid_t thread_id) : thread_id(thread_id), records_(std::make_unique<record[]>(capacity)) {}
+
+    // owning thread only
+    void push(event kind, const void* object, uint64_t arg) noexcept {
+        auto head = head_.load(std::memory_order_relaxed);
+        records_[head & (capacity - 1)] = record{timestamp(), object, arg, kind};
+        head_.store(head + 1, std::memory_order_release);
+    }
+
+    /**
+     * @brief Retained records, oldest first
+     *
+     * Exact once the writer is quiescent; while it keeps writing, the
+     * oldest records may be overwritten during the copy.
+     */
+    std::vector<record> snapshot() const {
+        auto head = head_.load(std::memory_order_acquire);
+        auto count = std::min<uint64_t>(head, capacity);
+        std::vector<record> result;
+        result.reserve(count);
+        for (auto i = head - count; i != head; i++) {
+            result.push_back(records_[i & (capacity - 1)]);
+        }
+        return result;
+    }
+
+    const pid_t thread_id;
+    // written and read under the registry's mutex
+    std::string thread_name;
+
+private:
+    alignas(cache_line_size) std::atomic<uint64_t> head_ = 0;
+    std::unique_ptr<record[]> records_;
+};
+
+/**
+ * @brief Owner of all rings; touched under its mutex only when a thread
+ *        records its first event or names itself, and when exporting
+ */
+class registry {
+public:
+    static registry& instance() {
+        static registry registry;
+        return registry;
+    }
+
+    ring& local() {
+        thread_local ring* local = nullptr;
+        if (local == nullptr) {
+            std::lock_guard lock(mutex_);
+            local = rings_.emplace_back(std::make_unique<ring>(gettid())).get();
+        }
+        return *local;
+    }
+
+    void set_thread_name(std::string name) {
+        auto& ring = local();
+        std::lock_guard lock(mutex_);
+        ring.thread_name = std::move(name);
+    }
+
+    template <typename Fn>
+    void for_each(Fn&& fn) {
+        std::lock_guard lock(mutex_);
+        for (auto& ring : rings_) {
+            fn(*ring);
+        }
+    }
+
+    // converts timestamps to nanoseconds since the registry's creation
+    auto clock_mapping() const {
+        auto ticks_per_ns = cycle_clock::ticks_per_ns();
+        return [anchor_ticks = anchor_ticks_, ticks_per_ns](uint64_t ticks) {
+            return (static_cast<double>(ticks) - static_cast<double>(anchor_ticks)) / ticks_per_ns;
+        };
+    }
+
+private:
+    registry() : anchor_ticks_(timestamp()) {}
+
+    std::mutex mutex_;
+    std::vector<std::unique_ptr<ring>> rings_;
+    uint64_t anchor_ticks_;
+};
+
+inline void emit(event kind, const void* object = nullptr, uint64_t arg = 0) noexcept {
+    try {
+        registry::instance().local().push(kind, object, arg);
+    } catch (...) {
+        // no memory for this thread's ring, drop the event
+    }
+}
+
+/**
+ * @brief Label the calling thread's track in exported traces
+ */
+inline void set_thread_name(std::string name) {
+    if constexpr (enabled) {
+        registry::instance().set_thread_name(std::move(name));
+    }
+}
+
+namespace detail {
+
+struct event_format {
+    const char* name;
+    // Chrome trace phase: i instant, B/E duration, b/e async
+    char phase;
+};
+
+inline event_format format_of(event kind) noexcept {
+    switch (kind) {
+        case event::queue_push:
+            return {"queue push", 'i'};
+        case event::queue_splice:
+            return {"queue splice", 'i'};
+        case event::task_run_begin:
+            return {"task", 'B'};
+        case event::task_run_end:
+            return {"task", 'E'};
+        case event::task_allocate:
+            return {"doca task allocate", 'i'};
+        case event::task_reuse:
+            return {"doca task reuse", 'i'};
+        case event::task_free:
+            return {"doca task free", 'i'};
+        case event::task_submit:
+            return {"doca task", 'b'};
+        case event::task_complete:
+            return {"doca task", 'e'};
+        case event::task_stopped:
+            return {"doca task stopped", 'i'};
+        case event::receiver_begin:
+            return {"receiver", 'B'};
+        case event::receiver_end:
+            return {"receiver", 'E'};
+        case event::buf_lookup:
+            return {"buf lookup", 'i'};
+        case event::buf_release:
+            return {"buf release", 'i'};
+        case event::connection_connect:
+            return {"connection connect", 'i'};
+        case event::connection_request:
+            return {"connection request", 'i'};
+        case event::connection_established:
+            return {"connection established", 'i'};
+        case event::connection_failure:
+            return {"connection failure", 'i'};
+        case event::connection_disconnected:
+            return {"connection disconnected", 'i'};
+        case event::context_state_changed:
+            return {"context state changed", 'i'};
+    }
+    return {"unknown", 'i'};
+}
+
+// writes `text` as the contents of a JSON string
+inline void write_json_escaped(std::ostream& out, std::string_view text) {
+    for (char c : text) {
+        switch (c) {
+            case '"':
+                out << "\\\"";
+                break;
+            case '\\':
+                out << "\\\\";
+                break;
+            case '\n':
+                out << "\\n";
+                break;
+            case '\t':
+                out << "\\t";
+                break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char escaped[8];
+                    snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(c));
+                    out << escaped;
+                } else {
+                    out << c;
+                }
+        }
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief Write every retained record in the Chrome trace event format
+ *
+ * DOCA tasks become async slices from submit to completion keyed by their
+ * operation, so a slice spans the time the work spent on the NIC.
+ */
+inline void write_chrome_trace(std::ostream& out) {
+    auto& registry = registry::instance();
+    auto to_ns = registry.clock_mapping();
+    auto pid = getpid();
+
+    out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    bool first = true;
+    auto separator = [&] {
+        if (!first) {
+            out << ",\n";
+        }
+        first = false;
+    };
+
+    registry.for_each([&](const ring& ring) {
+        if (!ring.thread_name.empty()) {
+            separator();
+            out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << pid << ",\"tid\":" << ring.thread_id
+                << ",\"args\":{\"name\":\"";
+            detail::write_json_escaped(out, ring.thread_name);
+            out << "\"}}";
+        }
+
+        for (const auto& record : ring.snapshot()) {
+            auto format = detail::format_of(record.kind);
+            char time[32];
+            snprintf(time, sizeof(time), "%.3f", to_ns(record.timestamp) / 1000.0);
+            char object[32];
+            snprintf(object, sizeof(object), "%p", record.object);
+
+            separator();
+            out << "{\"name\":\"" << format.name << "\",\"cat\":\"doca_stdexec\",\"ph\":\"" << format.phase
+                << "\",\"ts\":" << time << ",\"pid\":" << pid << ",\"tid\":" << ring.thread_id;
+            if (format.phase == 'b' || format.phase == 'e') {
+                out << ",\"id\":\"" << object << "\"";
+            }
+            if (format.phase == 'i') {
+                out << ",\"s\":\"t\"";
+            }
+            out << ",\"args\":{\"object\":\"" << object << "\",\"arg\":" << record.arg << "}}";
+        }
+    });
+
+    out << "]}\n";
+}
+
+/**
+ * @return false if the file cannot be written
+ */
+inline bool write_chrome_trace(const std::string& path) {
+    std::ofstream out(path);
+    if (!out) {
+        return false;
+    }
+    write_chrome_trace(out);
+    return static_cast<bool>(out);
+}
+
+} // namespace doca_stdexec::trace
+
+#endif // DOCA_STDEXEC_TRACE_HPP
@@ -0,0 +1,153 @@
+#pragma once
+#ifndef DOCA_STDEXEC_WORK_STEALING_HPP
+#define DOCA_STDEXEC_WORK_STEALING_HPP
+
+#include "doca_stdexec/common/chase_lev_deque.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace doca_stdexec {
+
+/**
+ * @brief A set of Chase-Lev deques whose tasks any member may steal
+ *
+ * Every member (a PE run loop) owns one deque and pushes the continuations
+ * that were explicitly scheduled as stealable onto it. Idle members and the
+ * optional helper threads steal from the others. Deques are owned by the
+ * group, so the group must outlive all its members.
+ *
+ * @tparam Task Task type with an `execute()` member
+ */
+template <typename Task>
+class basic_work_stealing_group {
+public:
+    using deque_type = chase_lev_deque<Task>;
+
+    explicit basic_work_stealing_group(size_t max_members = 64) : members_(max_members) {}
+
+    basic_work_stealing_group(const basic_work_stealing_group&) = delete;
+    basic_work_stealing_group& operator=(const basic_work_stealing_group&) = delete;
+
+    ~basic_work_stealing_group() {
+        stop_helpers();
+    }
+
+    /**
+     * @brief Register a new member
+     * @return The member's deque, to be pushed and popped by its thread only
+     */
+    deque_type* join() {
+        std::unique_lock lock(mutex_);
+        auto index = num_members_.load(std::memory_order_relaxed);
+        if (index == members_.size()) {
+            throw std::length_error("Work stealing group is full");
+        }
+
+        auto* deque = deques_.emplace_back(std::make_unique<deque_type>()).get();
+        members_[index].store(deque, std::memory_order_release);
+        num_members_.store(index + 1, std::memory_order_release);
+        return deque;
+    }
+
+    /**
+     * @brief Steal one task from any member but `self`
+     * @return The task, or nullptr if nothing could be stolen
+     */
+    Task* steal(const deque_type* self = nullptr) noexcept {
+        auto num_members = num_members_.load(std::memory_order_acquire);
+        if (num_members == 0) {
+            return nullptr;
+        }
+
+        // start at a random victim so thieves spread out
+        auto start = next_random_() % num_members;
+        for (size_t i = 0; i < num_members; i++) {
+            auto* victim = members_[(start + i) % num_members].load(std::memory_order_acquire);
+            if (victim == self) {
+                continue;
+            }
+            if (auto* task = victim->steal()) {
+                return task;
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief Spawn dedicated threads that only steal and execute tasks
+     */
+    void start_helpers(size_t count) {
+        std::unique_lock lock(mutex_);
+        for (size_t i = 0; i < count; i++) {
+            helpers_.emplace_back([this] { run_helper_(); });
+        }
+    }
+
+    void stop_helpers() {
+        std::vector<std::thread> helpers;
+        {
+            std::unique_lock lock(mutex_);
+            stop_.store(true, std::memory_order_release);
+            helpers.swap(helpers_);
+        }
+        for (auto& helper : helpers) {
+            helper.join();
+        }
+        stop_.store(false, std::memory_order_release);
+    }
+
+    [[nodiscard]]
+    size_t num_members() const noexcept {
+        return num_members_.load(std::memory_order_acquire);
+    }
+
+private:
+    static uint64_t next_random_() noexcept {
+        static thread_local uint64_t state = std::hash<std::thread::id>{}(std::this_thread::get_id()) | 1;
+        // xorshift64
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+
+    void run_helper_() noexcept {
+        size_t misses = 0;
+        while (!stop_.load(std::memory_order_acquire)) {
+            if (auto* task = steal()) {
+                task->execute();
+                misses = 0;
+                continue;
+            }
+
+            // back off from spinning to yielding to sleeping as misses pile up
+            if (++misses < 64) {
+                continue;
+            }
+            if (misses < 1024) {
+                std::this_thread::yield();
+            } else {
+                std::this_thread::sleep_for(std::chrono::microseconds(50));
+            }
+        }
+    }
+
+    std::vector<std::atomic<deque_type*>> members_;
+    std::atomic<size_t> num_members_{0};
+    std::vector<std::unique_ptr<deque_type>> deques_;
+    std::vector<std::thread> helpers_;
+    std::atomic<bool> stop_{false};
+    std::mutex mutex_;
+};
+
+} // namespace doca_stdexec
+
+#endif // DOCA_STDEXEC_WORK_STEALING_HPP
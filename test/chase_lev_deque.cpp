@@ -0,0 +1,119 @@
+// Races thieves against the owner of a chase_lev_deque. The owner keeps the
+// deque nearly empty so that its pops fight the steals for the last item,
+// and starts small so that the ring grows under the thieves. Every item must
+// be taken exactly once, by either side.
+
+#include <doca_stdexec/common/chase_lev_deque.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdio>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace doca_stdexec;
+
+namespace {
+
+struct item {
+    std::atomic<int> taken = 0;
+};
+
+int failures = 0;
+
+void check(bool ok, const char* what) {
+    if (!ok) {
+        printf("FAIL: %s\n", what);
+        failures++;
+    }
+}
+
+void single_thread() {
+    chase_lev_deque<item> deque(2);
+    item items[8];
+
+    check(deque.pop() == nullptr && deque.steal() == nullptr, "empty deque yields nothing");
+    // grows twice
+    for (auto& i : items) {
+        deque.push(&i);
+    }
+    check(deque.size() == 8, "size after pushes");
+    check(deque.steal() == &items[0], "steal takes the oldest item");
+    check(deque.pop() == &items[7], "pop takes the newest item");
+    for (size_t i = 6; i >= 1; i--) {
+        check(deque.pop() == &items[i], "pop keeps LIFO order across growth");
+    }
+    check(deque.empty() && deque.pop() == nullptr, "deque is empty");
+}
+
+void steal_races_pop() {
+    constexpr size_t thieves = 3;
+    constexpr size_t count = 200000;
+
+    auto items = std::make_unique<item[]>(count);
+    chase_lev_deque<item> deque(2);
+    std::atomic<bool> done = false;
+    std::atomic<size_t> stolen = 0;
+
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < thieves; t++) {
+        threads.emplace_back([&] {
+            size_t mine = 0;
+            while (!done.load(std::memory_order_acquire)) {
+                if (auto* i = deque.steal()) {
+                    i->taken.fetch_add(1, std::memory_order_relaxed);
+                    mine++;
+                }
+            }
+            stolen.fetch_add(mine, std::memory_order_relaxed);
+        });
+    }
+
+    size_t popped = 0;
+    size_t next = 0;
+    while (next < count) {
+        // a burst of one to eight items, which the owner pops back while
+        // the thieves steal from the other end
+        auto burst = 1 + next % 8;
+        for (size_t i = 0; i < burst && next < count; i++) {
+            deque.push(&items[next++]);
+        }
+        // now and then let the thieves run against a full burst, which
+        // matters when they share a core with the owner
+        if (next % 1024 < 8) {
+            std::this_thread::yield();
+        }
+        while (auto* i = deque.pop()) {
+            i->taken.fetch_add(1, std::memory_order_relaxed);
+            popped++;
+        }
+    }
+    done.store(true, std::memory_order_release);
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    size_t once = 0;
+    for (size_t i = 0; i < count; i++) {
+        once += items[i].taken.load(std::memory_order_relaxed) == 1;
+    }
+    printf("popped %zu, stolen %zu\n", popped, stolen.load());
+    check(once == count, "race: an item was lost or taken twice");
+    check(popped + stolen.load() == count, "race: pops and steals add up to the items pushed");
+    check(deque.empty(), "race: deque is empty");
+}
+
+} // namespace
+
+int main() {
+    single_thread();
+    steal_races_pop();
+
+    if (failures != 0) {
+        printf("FAIL: %d checks failed\n", failures);
+        return 1;
+    }
+    printf("PASS\n");
+    return 0;
+}
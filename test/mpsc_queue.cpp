@@ -0,0 +1,125 @@
+// Checks mpsc_queue::take_all: a batch comes out oldest first and lands
+// behind what the consumer already holds, and with producers pushing
+// concurrently every node is taken exactly once, in each producer's order.
+
+#include <doca_stdexec/common/mpsc_queue.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdio>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace doca_stdexec;
+
+namespace {
+
+struct node {
+    std::atomic<node*> next = nullptr;
+    size_t producer = 0;
+    size_t sequence = 0;
+};
+
+int failures = 0;
+
+void check(bool ok, const char* what) {
+    if (!ok) {
+        printf("FAIL: %s\n", what);
+        failures++;
+    }
+}
+
+void single_thread() {
+    mpsc_queue<node> queue;
+    intrusive_queue<node> local;
+
+    check(queue.take_all(local) == 0, "take_all on an empty queue moves nothing");
+    check(local.empty(), "take_all on an empty queue leaves the target empty");
+
+    node nodes[5];
+    for (size_t i = 0; i < 5; i++) {
+        nodes[i].sequence = i;
+    }
+
+    // a node the consumer already holds stays in front of the batch
+    local.push(&nodes[0]);
+    for (size_t i = 1; i < 5; i++) {
+        queue.push(&nodes[i]);
+    }
+    check(!queue.empty(), "queue is not empty after a push");
+    check(queue.take_all(local) == 4, "take_all reports the batch size");
+    check(queue.empty(), "queue is empty after take_all");
+
+    for (size_t i = 0; i < 5; i++) {
+        auto* n = local.pop();
+        check(n == &nodes[i], "take_all keeps push order behind existing nodes");
+    }
+    check(local.pop() == nullptr, "nothing left after the batch");
+
+    // the target is usable again once drained
+    queue.push(&nodes[0]);
+    check(queue.take_all(local) == 1 && local.pop() == &nodes[0], "take_all into a drained queue");
+}
+
+void concurrent_producers() {
+    constexpr size_t producers = 4;
+    constexpr size_t per_producer = 200000;
+
+    std::vector<std::unique_ptr<node[]>> nodes;
+    for (size_t p = 0; p < producers; p++) {
+        nodes.push_back(std::make_unique<node[]>(per_producer));
+    }
+    mpsc_queue<node> queue;
+    std::atomic<bool> go = false;
+
+    std::vector<std::thread> threads;
+    for (size_t p = 0; p < producers; p++) {
+        threads.emplace_back([&, p] {
+            while (!go.load(std::memory_order_acquire)) {
+            }
+            for (size_t i = 0; i < per_producer; i++) {
+                auto& n = nodes[p][i];
+                n.producer = p;
+                n.sequence = i;
+                queue.push(&n);
+            }
+        });
+    }
+
+    go.store(true, std::memory_order_release);
+    intrusive_queue<node> local;
+    std::vector<size_t> expected(producers, 0);
+    size_t taken = 0;
+    size_t reported = 0;
+    bool in_order = true;
+    while (taken < producers * per_producer) {
+        reported += queue.take_all(local);
+        while (auto* n = local.pop()) {
+            in_order &= n->sequence == expected[n->producer];
+            expected[n->producer] = n->sequence + 1;
+            taken++;
+        }
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    check(in_order, "concurrent: a producer's nodes were taken out of order");
+    check(reported == taken, "concurrent: take_all counts match the nodes taken");
+    check(queue.empty() && queue.take_all(local) == 0, "concurrent: nothing left once every node was taken");
+}
+
+} // namespace
+
+int main() {
+    single_thread();
+    concurrent_producers();
+
+    if (failures != 0) {
+        printf("FAIL: %d checks failed\n", failures);
+        return 1;
+    }
+    printf("PASS\n");
+    return 0;
+}
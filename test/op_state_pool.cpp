@@ -0,0 +1,251 @@
+// Counts heap allocations of operations spawned from the PE thread with
+// spawn_detached. Once the loop's pool has warmed up, a batch of spawned
+// operations must not allocate at all, neither plain tasks nor RDMA writes
+// over a loopback connection.
+
+#include <doca_stdexec/allocator.hpp>
+#include <doca_stdexec/buf.hpp>
+#include <doca_stdexec/buf_inventory.hpp>
+#include <doca_stdexec/common/tcp.hpp>
+#include <doca_stdexec/device.hpp>
+#include <doca_stdexec/mmap.hpp>
+#include <doca_stdexec/progress_engine.hpp>
+#include <doca_stdexec/rdma.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <exec/async_scope.hpp>
+#include <memory>
+#include <new>
+#include <optional>
+#include <stdexec/execution.hpp>
+#include <sys/socket.h>
+#include <vector>
+
+namespace {
+
+std::atomic<bool> counting = false;
+std::atomic<size_t> allocations = 0;
+
+void count_allocation() noexcept {
+    if (counting.load(std::memory_order_relaxed)) {
+        allocations.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+} // namespace
+
+void* operator new(size_t size) {
+    count_allocation();
+    if (auto* p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+// over-aligned operation states, e.g. the pool allocator's fallback
+void* operator new(size_t size, std::align_val_t alignment) {
+    count_allocation();
+    auto align = static_cast<size_t>(alignment);
+    // aligned_alloc wants a multiple of the alignment
+    if (auto* p = std::aligned_alloc(align, (std::max<size_t>(size, 1) + align - 1) / align * align)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::align_val_t) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, size_t, std::align_val_t) noexcept {
+    std::free(p);
+}
+
+using namespace doca_stdexec;
+
+namespace {
+
+constexpr size_t batch_size = 4096;
+constexpr size_t rounds = 16;
+// RDMA writes in flight at once, each with its own pair of buffers
+constexpr size_t writes = 256;
+constexpr size_t message_size = 64;
+
+/**
+ * @brief Spawns `count` senders made by `make(i)` from the PE thread and
+ *        waits until all of them completed
+ * @return Heap allocations from the first spawn to the last completion
+ */
+template <typename Make>
+size_t spawn_batch(doca_pe_context& context, size_t count, Make make) {
+    auto scheduler = context.get_scheduler();
+    // only tracks the spawned operations, whose states come from the pool
+    exec::async_scope scope;
+    std::atomic<size_t> remaining = count;
+
+    stdexec::sync_wait(stdexec::schedule(scheduler) | stdexec::then([&] {
+                           allocations.store(0, std::memory_order_relaxed);
+                           counting.store(true, std::memory_order_relaxed);
+                           for (size_t i = 0; i < count; i++) {
+                               spawn_detached(scope.nest(make(i) | stdexec::then([&] {
+                                                             // runs on the PE thread, like the spawns
+                                                             if (remaining.fetch_sub(1) == 1) {
+                                                                 counting.store(false, std::memory_order_relaxed);
+                                                             }
+                                                         })));
+                           }
+                       }));
+    stdexec::sync_wait(scope.on_empty());
+    return allocations.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Warms the pool up with one batch, then runs `rounds` more
+ * @return Heap allocations of the rounds after the warm-up
+ */
+template <typename Make>
+size_t measure(const char* name, doca_pe_context& context, size_t count, Make make) {
+    auto warmup = spawn_batch(context, count, make);
+    printf("%s warm-up: %zu allocations for %zu operations\n", name, warmup, count);
+
+    size_t steady = 0;
+    for (size_t i = 0; i < rounds; i++) {
+        steady += spawn_batch(context, count, make);
+    }
+    printf("%s steady state: %zu allocations for %zu operations, %.3f per operation\n", name, steady,
+           rounds * count, static_cast<double>(steady) / static_cast<double>(rounds * count));
+    return steady;
+}
+
+/**
+ * @brief An Rdma on `context` connected to a peer on its own PE thread, and
+ *        `writes` pairs of local and remote buffers to write between
+ */
+struct loopback_writes {
+    std::shared_ptr<Device> device;
+    doca_pe_context& context;
+    doca_pe_context peer_context;
+    std::shared_ptr<rdma::Rdma> rdma;
+    std::shared_ptr<rdma::Rdma> peer_rdma;
+    std::optional<rdma::RdmaConnection> connection;
+    std::optional<rdma::RdmaConnection> peer;
+
+    std::vector<uint8_t> local_memory = std::vector<uint8_t>(writes * message_size);
+    std::vector<uint8_t> remote_memory = std::vector<uint8_t>(writes * message_size);
+    std::optional<MMap<uint8_t>> local_mmap;
+    // stands in for the peer's registration of remote_memory
+    std::optional<MMap<uint8_t>> exported_mmap;
+    std::optional<MMap<uint8_t>> remote_mmap;
+    BufInventory inventory{2 * writes};
+    std::vector<Buf> src;
+    std::vector<Buf> dst;
+
+    explicit loopback_writes(doca_pe_context& ctx) : device(Device::open_from_ib_name("mlx5_0")), context(ctx) {
+        rdma = start_rdma_(context);
+        peer_rdma = start_rdma_(peer_context);
+
+        int fds[2];
+        if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) < 0) {
+            throw tcp::socket_error("Failed to create socket pair");
+        }
+        tcp::tcp_socket a{fds[0]};
+        tcp::tcp_socket b{fds[1]};
+        auto [local, remote] =
+            stdexec::sync_wait(stdexec::when_all(
+                                   stdexec::schedule(context.get_scheduler()) |
+                                       stdexec::let_value([&] { return rdma->connect(a); }),
+                                   stdexec::schedule(peer_context.get_scheduler()) |
+                                       stdexec::let_value([&] { return peer_rdma->connect(b); })))
+                .value();
+        connection.emplace(std::move(local));
+        peer.emplace(std::move(remote));
+
+        constexpr uint32_t permissions =
+            DOCA_ACCESS_FLAG_LOCAL_READ_WRITE | DOCA_ACCESS_FLAG_RDMA_READ | DOCA_ACCESS_FLAG_RDMA_WRITE;
+        local_mmap.emplace(std::span<uint8_t>(local_memory));
+        local_mmap->add_device(device);
+        local_mmap->set_permissions(permissions);
+        local_mmap->start();
+
+        exported_mmap.emplace(std::span<uint8_t>(remote_memory));
+        exported_mmap->add_device(device);
+        exported_mmap->set_permissions(permissions);
+        exported_mmap->start();
+        auto desc = exported_mmap->export_rdma(*device);
+
+        doca_data user_data{};
+        remote_mmap.emplace(MMap<uint8_t>::create_from_export(&user_data, desc.data(), desc.size(), device));
+
+        inventory.start();
+        for (size_t i = 0; i < writes; i++) {
+            auto& s = src.emplace_back(
+                inventory.get_buffer_by_addr(*local_mmap, local_memory.data() + i * message_size, message_size));
+            s.set_data_len(message_size);
+            dst.emplace_back(inventory.get_buffer_by_addr(
+                *remote_mmap, remote_mmap->get_memrange().data() + i * message_size, message_size));
+        }
+    }
+
+    ~loopback_writes() {
+        connection.reset();
+        peer.reset();
+        stdexec::sync_wait(stdexec::schedule(context.get_scheduler()) | stdexec::then([&] { rdma->stop(); }));
+        stdexec::sync_wait(stdexec::schedule(peer_context.get_scheduler()) |
+                           stdexec::then([&] { peer_rdma->stop(); }));
+    }
+
+    // DOCA appends to the destination's data segment, so every write
+    // rewinds its own and lands on the same bytes
+    auto write(size_t i) {
+        dst[i].set_data_len(0);
+        return connection->write(src[i], dst[i]);
+    }
+
+private:
+    std::shared_ptr<rdma::Rdma> start_rdma_(doca_pe_context& ctx) {
+        auto r = rdma::Rdma::open_from_dev(device);
+        r->set_gid_index(1);
+        stdexec::sync_wait(stdexec::schedule(ctx.get_scheduler()) | stdexec::then([&] {
+                               ctx.connect_ctx(r);
+                               r->start();
+                           }));
+        return r;
+    }
+};
+
+} // namespace
+
+int main() {
+    // queue every spawned operation so that a whole batch is alive at once
+    doca_pe_context context{loop::run_loop_options{.max_inline_depth = 0}};
+
+    auto scheduler = context.get_scheduler();
+    auto steady = measure("schedule", context, batch_size, [&](size_t) { return stdexec::schedule(scheduler); });
+
+    {
+        loopback_writes loopback{context};
+        steady += measure("rdma write", context, writes, [&](size_t i) { return loopback.write(i); });
+    }
+
+    auto stats = context.stats();
+    printf("pool: %llu blocks allocated, %llu recycled\n", static_cast<unsigned long long>(stats.frames_allocated),
+           static_cast<unsigned long long>(stats.frames_recycled));
+
+    if (steady != 0) {
+        printf("FAIL: spawned operations still allocate in steady state\n");
+        return 1;
+    }
+    printf("PASS\n");
+    return 0;
+}
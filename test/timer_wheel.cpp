@@ -0,0 +1,180 @@
+// Drives a timer_wheel by hand, without a run loop. Every timer must fire in
+// the advance() that first reaches its deadline: never earlier, never later,
+// whether it started on level 0, had to cascade down from a higher level or
+// waited in the overflow list. Timers removed on any level must never fire.
+
+#include <doca_stdexec/common/timer_wheel.hpp>
+
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace doca_stdexec;
+
+namespace {
+
+constexpr uint64_t level_span(unsigned level) {
+    return 1ULL << (timer_wheel::slot_bits * level);
+}
+
+// beyond the highest level, timers start in the overflow list
+constexpr uint64_t range = level_span(timer_wheel::num_levels);
+
+int failures = 0;
+
+void check(bool ok, const char* what) {
+    if (!ok) {
+        printf("FAIL: %s\n", what);
+        failures++;
+    }
+}
+
+// the window of the advance() in progress, checked by every firing timer
+uint64_t window_begin = 0;
+uint64_t window_end = 0;
+bool fired_out_of_window = false;
+
+struct probe : timer_node {
+    explicit probe(uint64_t at) {
+        deadline = at;
+        fire = [](timer_node* node) noexcept {
+            auto* self = static_cast<probe*>(node);
+            self->fired++;
+            if (self->deadline <= window_begin || self->deadline > window_end) {
+                fired_out_of_window = true;
+            }
+        };
+    }
+
+    int fired = 0;
+};
+
+size_t advance(timer_wheel& wheel, uint64_t from, uint64_t to) {
+    window_begin = from;
+    window_end = to;
+    return wheel.advance(to);
+}
+
+/**
+ * @brief Deadlines on both sides of every level boundary and of the
+ *        overflow list, each of which must fire exactly on its tick
+ */
+void boundaries() {
+    std::vector<uint64_t> deadlines;
+    for (unsigned level = 1; level <= timer_wheel::num_levels; level++) {
+        deadlines.push_back(level_span(level) - 1);
+        deadlines.push_back(level_span(level));
+        deadlines.push_back(level_span(level) + 1);
+    }
+    // several top-level wraps out, so the overflow list is rescanned more than once
+    deadlines.push_back(3 * range + 5);
+
+    timer_wheel wheel{0};
+    std::vector<probe> probes(deadlines.begin(), deadlines.end());
+    for (auto& p : probes) {
+        wheel.insert(&p);
+    }
+    check(wheel.size() == probes.size(), "boundaries: every timer is armed");
+
+    uint64_t now = 0;
+    for (auto& p : probes) {
+        // one tick short: nothing may fire yet
+        advance(wheel, now, p.deadline - 1);
+        check(p.fired == 0, "boundaries: timer fired early");
+        advance(wheel, p.deadline - 1, p.deadline);
+        check(p.fired == 1, "boundaries: timer did not fire on its deadline");
+        now = p.deadline;
+    }
+    check(wheel.empty(), "boundaries: wheel is empty after the last deadline");
+    check(!wheel.next_expiry().has_value(), "boundaries: no expiry once empty");
+}
+
+/**
+ * @brief Random deadlines across all levels and the overflow list, reached
+ *        in random steps from a single tick to whole top-level wraps
+ */
+void random_steps() {
+    constexpr size_t count = 20000;
+    std::mt19937_64 rng(42);
+    std::uniform_int_distribution<uint64_t> deadline(1, 4 * range);
+
+    timer_wheel wheel{0};
+    std::vector<probe> probes;
+    probes.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        wheel.insert(&probes.emplace_back(deadline(rng)));
+    }
+
+    std::uniform_int_distribution<unsigned> shift(0, 22);
+    uint64_t now = 0;
+    size_t fired = 0;
+    while (!wheel.empty()) {
+        auto to = now + (1ULL << shift(rng)) + rng() % 64;
+        fired += advance(wheel, now, to);
+        now = to;
+    }
+
+    check(fired == count, "random: advance reports every timer fired");
+    check(!fired_out_of_window, "random: a timer fired outside the advance that reached it");
+    size_t once = 0;
+    for (auto& p : probes) {
+        once += p.fired == 1;
+    }
+    check(once == count, "random: every timer fired exactly once");
+}
+
+/**
+ * @brief Removes timers while they sit on levels other than level 0, before
+ *        and after they cascade, and in the overflow list
+ */
+void cancel() {
+    timer_wheel wheel{0};
+
+    probe near{10};
+    probe level2{level_span(2) + 100};
+    probe cascaded{level_span(2) + 900};
+    probe overflow{range + 7};
+    probe kept{range + 8};
+    for (auto* p : {&near, &level2, &cascaded, &overflow, &kept}) {
+        wheel.insert(p);
+    }
+
+    // still on level 2
+    wheel.remove(&level2);
+    check(!level2.is_linked(), "cancel: removed timer is unlinked");
+    check(wheel.size() == 4, "cancel: size drops on remove");
+
+    // crossing the level-2 boundary moves `cascaded` down to level 1
+    advance(wheel, 0, level_span(2));
+    check(near.fired == 1, "cancel: level-0 neighbour still fires");
+    check(cascaded.is_linked() && cascaded.fired == 0, "cancel: cascaded timer is still armed");
+    wheel.remove(&cascaded);
+
+    wheel.remove(&overflow);
+    // removing twice is a no-op
+    wheel.remove(&overflow);
+    check(wheel.size() == 1, "cancel: only the kept timer remains");
+
+    advance(wheel, level_span(2), 2 * range);
+    check(level2.fired == 0, "cancel: timer removed from level 2 fired");
+    check(cascaded.fired == 0, "cancel: timer removed after cascading fired");
+    check(overflow.fired == 0, "cancel: timer removed from the overflow list fired");
+    check(kept.fired == 1, "cancel: timer next to a removed overflow timer did not fire");
+    check(wheel.empty(), "cancel: wheel is empty");
+}
+
+} // namespace
+
+int main() {
+    boundaries();
+    random_steps();
+    cancel();
+
+    if (failures != 0) {
+        printf("FAIL: %d checks failed\n", failures);
+        return 1;
+    }
+    printf("PASS\n");
+    return 0;
+}
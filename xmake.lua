@@ -13,6 +13,25 @@ add_requires("pkgconfig::doca-sha", { alias = "doca-sha" })
 
 add_requires("stdexec main")
 
+option("trace")
+    set_default(false)
+    set_showmenu(true)
+    set_description("Record operation lifecycle events (doca_stdexec/trace.hpp)")
+option_end()
+
+option("latency_histograms")
+    set_default(true)
+    set_showmenu(true)
+    set_description("Record RDMA task latencies (doca_stdexec/rdma/latency.hpp)")
+option_end()
+
+if has_config("trace") then
+    add_defines("DOCA_STDEXEC_TRACE")
+end
+if not has_config("latency_histograms") then
+    add_defines("DOCA_STDEXEC_LATENCY_HISTOGRAMS=0")
+end
+
 target("doca-stdexec")
     set_kind("headeronly")
     add_includedirs("include", { public = true })
@@ -38,6 +57,29 @@ target("rdma_loopback")
     add_deps("doca-stdexec")
     add_packages("stdexec")
 
+target("op_state_pool")
+    set_kind("binary")
+    add_files("test/op_state_pool.cpp")
+    add_deps("doca-stdexec")
+    add_packages("stdexec")
+
+for _, name in ipairs({"timer_wheel", "mpsc_queue", "chase_lev_deque"}) do
+    target(name)
+        set_kind("binary")
+        add_files("test/" .. name .. ".cpp")
+        add_deps("doca-stdexec")
+        add_packages("stdexec")
+end
+
+for _, name in ipairs({"schedule_contention", "adaptive_progress", "sharded_scaling", "work_stealing", "numa_placement", "timers", "mixed_load", "inline_schedule", "trace_write", "priority_classes", "handoff", "coro_echo", "caller_driven", "multiplexed_tenants", "chained_rdma", "message_rate", "backpressure", "doorbell_batch", "bulk_transfer", "gather_write", "write_notify"}) do
+    target(name)
+        set_kind("binary")
+        set_group("bench")
+        add_files("bench/" .. name .. ".cpp")
+        add_deps("doca-stdexec")
+        add_packages("stdexec")
+end
+
 target("doca-stdexec")
     set_kind("headeronly")
     add_includedirs("include", { public = true })